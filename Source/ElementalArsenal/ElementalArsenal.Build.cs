@@ -12,6 +12,7 @@ public class ElementalArsenal : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
+				"NetCore",
 				"GameplayAbilities",
 				"GameplayTags",
 				"GameplayTasks"
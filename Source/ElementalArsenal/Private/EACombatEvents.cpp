@@ -0,0 +1,124 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "EACombatEvents.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+std::atomic<int32> FEACombatEventStream::NumConsumers(0);
+
+namespace EACombatEvents
+{
+	static int32 RingCapacity = 4096;
+	static FAutoConsoleVariableRef CVarRingCapacity(
+		TEXT("ea.Events.RingCapacity"),
+		RingCapacity,
+		TEXT("Combat events buffered per publishing thread, rounded up to a power of two. Only affects rings created afterwards."));
+
+	// Single producer / single consumer ring. Head and Tail only ever grow; the slot is the value masked.
+	struct FRing
+	{
+		explicit FRing(uint32 Capacity)
+			: Mask(Capacity - 1)
+		{
+			Events.SetNum(Capacity);
+		}
+
+		TArray<FEACombatEvent> Events;
+		const uint32 Mask;
+
+		// Next slot to write, only advanced by the owning thread
+		std::atomic<uint32> Head{0};
+
+		// Next slot to read, only advanced under DrainLock
+		std::atomic<uint32> Tail{0};
+
+		FRing* Next = nullptr;
+	};
+
+	// Every ring ever created. Rings are never freed: a consumer may still be reading one when its thread exits,
+	// and engine threads are pooled, so the list stays short.
+	static std::atomic<FRing*> Rings(nullptr);
+	static std::atomic<uint64> NumDropped(0);
+	static FCriticalSection DrainLock;
+	static thread_local FRing* ThreadRing = nullptr;
+
+	static FRing* CreateThreadRing()
+	{
+		FRing* Ring = new FRing(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(RingCapacity, 16))));
+
+		Ring->Next = Rings.load(std::memory_order_relaxed);
+		while (!Rings.compare_exchange_weak(Ring->Next, Ring, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		return Ring;
+	}
+}
+
+void FEACombatEventStream::RegisterConsumer()
+{
+	NumConsumers.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FEACombatEventStream::UnregisterConsumer()
+{
+	const int32 PreviousConsumers = NumConsumers.fetch_sub(1, std::memory_order_relaxed);
+	check(PreviousConsumers > 0);
+}
+
+void FEACombatEventStream::Publish(const FEACombatEvent& Event)
+{
+	using namespace EACombatEvents;
+
+	if (!IsActive())
+	{
+		return;
+	}
+
+	if (!ThreadRing)
+	{
+		ThreadRing = CreateThreadRing();
+	}
+
+	FRing& Ring = *ThreadRing;
+	const uint32 Head = Ring.Head.load(std::memory_order_relaxed);
+	const uint32 Tail = Ring.Tail.load(std::memory_order_acquire);
+
+	// Full: never wait for the consumer
+	if (Head - Tail > Ring.Mask)
+	{
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Ring.Events.GetData()[Head & Ring.Mask] = Event;
+	Ring.Head.store(Head + 1, std::memory_order_release);
+}
+
+int32 FEACombatEventStream::Drain(TFunctionRef<void(const FEACombatEvent&)> Visitor, int32 MaxEvents)
+{
+	using namespace EACombatEvents;
+
+	// Only consumers take this lock, producers never wait on it
+	FScopeLock Lock(&DrainLock);
+
+	int32 NumVisited = 0;
+	for (FRing* Ring = Rings.load(std::memory_order_acquire); Ring && NumVisited < MaxEvents; Ring = Ring->Next)
+	{
+		const uint32 Head = Ring->Head.load(std::memory_order_acquire);
+		uint32 Tail = Ring->Tail.load(std::memory_order_relaxed);
+
+		for (; Tail != Head && NumVisited < MaxEvents; ++Tail, ++NumVisited)
+		{
+			Visitor(Ring->Events.GetData()[Tail & Ring->Mask]);
+		}
+
+		// Hands the visited slots back to the producer
+		Ring->Tail.store(Tail, std::memory_order_release);
+	}
+	return NumVisited;
+}
+
+uint64 FEACombatEventStream::GetNumDropped()
+{
+	return EACombatEvents::NumDropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,271 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "EACombatLog.h"
+#include "Gas/EAReactionTypes.h"
+#include "ElementalArsenal.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+namespace EACombatLog
+{
+	// Buffered bytes handed to the writer task at once
+	static constexpr int32 FlushThreshold = 1024 * 1024;
+
+	struct FRecording
+	{
+		FString FilePath;
+		TUniquePtr<FArchive> Writer;
+		TArray<uint8> Buffer;
+		TMap<FName, uint32> NameIndices;
+		TArray<FName> Names;
+		uint64 NumRecords = 0;
+
+		// Latest write. Writes are chained, so this completes after all earlier ones.
+		UE::Tasks::FTask WriteTask;
+
+		// Set by a writer task when the archive reports an error. Later chunks are skipped.
+		std::atomic<bool> bWriteFailed = false;
+	};
+
+	static TUniquePtr<FRecording> Recording;
+
+	template<typename T>
+	static void Append(TArray<uint8>& Buffer, const T& Value)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	static uint32 GetNameIndex(FRecording& State, FName Name)
+	{
+		if (Name.IsNone())
+		{
+			return NoName;
+		}
+
+		if (const uint32* Index = State.NameIndices.Find(Name))
+		{
+			return *Index;
+		}
+
+		const uint32 Index = State.Names.Add(Name);
+		State.NameIndices.Add(Name, Index);
+		return Index;
+	}
+
+	static void FlushBuffer(FRecording& State)
+	{
+		if (State.Buffer.Num() == 0)
+		{
+			return;
+		}
+
+		auto WriteChunk = [Writer = State.Writer.Get(), bWriteFailed = &State.bWriteFailed, Chunk = MoveTemp(State.Buffer)]() mutable
+		{
+			if (!bWriteFailed->load(std::memory_order_relaxed))
+			{
+				Writer->Serialize(Chunk.GetData(), Chunk.Num());
+				if (Writer->IsError())
+				{
+					bWriteFailed->store(true, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		State.WriteTask = State.WriteTask.IsValid()
+			? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteChunk), UE::Tasks::Prerequisites(State.WriteTask))
+			: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteChunk));
+
+		State.Buffer.Reset(FlushThreshold + 1024);
+	}
+
+	// Drops a recording whose file can no longer be written. Game thread only.
+	static void AbortRecording()
+	{
+		TUniquePtr<FRecording> State = MoveTemp(Recording);
+		State->WriteTask.Wait();
+		State->Writer->Close();
+
+		UE_LOG(LogElementalArsenal, Error, TEXT("Combat log %s: write failed after %llu decisions, recording stopped. The file is incomplete."), *State->FilePath, State->NumRecords);
+	}
+
+	static void StartCommand(const TArray<FString>& Args)
+	{
+		FEACombatRecorder::Start(Args.Num() > 0 ? Args[0] : FString());
+	}
+
+	static FAutoConsoleCommand StartRecordingCommand(
+		TEXT("ea.CombatLog.Start"),
+		TEXT("Records every reaction decision to a binary combat log. Usage: ea.CombatLog.Start [File]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&StartCommand));
+
+	static FAutoConsoleCommand StopRecordingCommand(
+		TEXT("ea.CombatLog.Stop"),
+		TEXT("Finishes the combat log started with ea.CombatLog.Start."),
+		FConsoleCommandDelegate::CreateStatic(&FEACombatRecorder::Stop));
+}
+
+bool FEACombatRecorder::Start(const FString& FilePath)
+{
+	using namespace EACombatLog;
+
+	check(IsInGameThread());
+
+	if (Recording.IsValid())
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("Combat log already recording to %s"), *Recording->FilePath);
+		return false;
+	}
+
+	TUniquePtr<FRecording> State = MakeUnique<FRecording>();
+	State->FilePath = FilePath.IsEmpty()
+		? FPaths::ProjectSavedDir() / TEXT("CombatLogs") / (FDateTime::Now().ToString() + TEXT(".eacr"))
+		: FilePath;
+
+	State->Writer.Reset(IFileManager::Get().CreateFileWriter(*State->FilePath));
+	if (!State->Writer.IsValid())
+	{
+		UE_LOG(LogElementalArsenal, Error, TEXT("Could not create combat log %s"), *State->FilePath);
+		return false;
+	}
+
+	// Placeholder, rewritten by Stop once the counts are known
+	FFileHeader Header;
+	State->Writer->Serialize(&Header, sizeof(Header));
+	if (State->Writer->IsError())
+	{
+		UE_LOG(LogElementalArsenal, Error, TEXT("Could not write combat log %s"), *State->FilePath);
+		return false;
+	}
+	State->Buffer.Reserve(FlushThreshold + 1024);
+
+	UE_LOG(LogElementalArsenal, Log, TEXT("Recording combat log to %s"), *State->FilePath);
+	Recording = MoveTemp(State);
+	return true;
+}
+
+void FEACombatRecorder::Stop()
+{
+	using namespace EACombatLog;
+
+	check(IsInGameThread());
+
+	if (!Recording.IsValid())
+	{
+		return;
+	}
+
+	TUniquePtr<FRecording> State = MoveTemp(Recording);
+	FlushBuffer(*State);
+	State->WriteTask.Wait();
+
+	FArchive& Writer = *State->Writer;
+	if (State->bWriteFailed)
+	{
+		Writer.Close();
+		UE_LOG(LogElementalArsenal, Error, TEXT("Combat log %s: write failed, the file is incomplete."), *State->FilePath);
+		return;
+	}
+
+	// 1. Name table
+	FFileHeader Header;
+	Header.NumRecords = State->NumRecords;
+	Header.NameTableOffset = Writer.Tell();
+
+	uint32 NumNames = State->Names.Num();
+	Writer.Serialize(&NumNames, sizeof(NumNames));
+	for (const FName Name : State->Names)
+	{
+		const FTCHARToUTF8 Utf8(*Name.ToString());
+		uint16 Length = static_cast<uint16>(Utf8.Length());
+		Writer.Serialize(&Length, sizeof(Length));
+		Writer.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Length);
+	}
+
+	// 2. Final header
+	Writer.Seek(0);
+	Writer.Serialize(&Header, sizeof(Header));
+	if (Writer.IsError() || !Writer.Close())
+	{
+		UE_LOG(LogElementalArsenal, Error, TEXT("Combat log %s: could not write the name table and header, the file is incomplete."), *State->FilePath);
+		return;
+	}
+
+	UE_LOG(LogElementalArsenal, Log, TEXT("Combat log %s: %llu decisions, %d names"), *State->FilePath, State->NumRecords, NumNames);
+}
+
+bool FEACombatRecorder::IsRecording()
+{
+	return EACombatLog::Recording.IsValid();
+}
+
+void FEACombatRecorder::RecordDecision(const FGameplayTagContainer& SourceTags, const FGameplayTagContainer& TargetTags, const UClass* DamageEffect, float Damage,
+	TConstArrayView<const FElementalReactionRule*> Matches, TConstArrayView<const FElementalReactionRule*> Applied, bool bAppliedKnown)
+{
+	using namespace EACombatLog;
+
+	check(IsInGameThread());
+
+	if (!Recording.IsValid())
+	{
+		return;
+	}
+
+	if (Recording->bWriteFailed)
+	{
+		AbortRecording();
+		return;
+	}
+
+	FRecording& State = *Recording;
+
+	FRecordHeader Record;
+	Record.Frame = GFrameCounter;
+	Record.Damage = Damage;
+	Record.DamageEffect = DamageEffect ? GetNameIndex(State, DamageEffect->GetFName()) : NoName;
+	Record.NumSourceTags = static_cast<uint16>(FMath::Min(SourceTags.Num(), int32(MAX_uint16)));
+	Record.NumTargetTags = static_cast<uint16>(FMath::Min(TargetTags.Num(), int32(MAX_uint16)));
+	Record.NumMatches = static_cast<uint16>(FMath::Min(Matches.Num(), int32(MAX_uint16)));
+	Record.NumApplied = bAppliedKnown ? static_cast<uint16>(FMath::Min(Applied.Num(), int32(AppliedUnknown) - 1)) : AppliedUnknown;
+	Append(State.Buffer, Record);
+
+	// Explicit tags only; the replay rebuilds the parent tags when it fills its containers
+	for (int32 TagIndex = 0; TagIndex < Record.NumSourceTags; ++TagIndex)
+	{
+		Append(State.Buffer, GetNameIndex(State, SourceTags.GetByIndex(TagIndex).GetTagName()));
+	}
+	for (int32 TagIndex = 0; TagIndex < Record.NumTargetTags; ++TagIndex)
+	{
+		Append(State.Buffer, GetNameIndex(State, TargetTags.GetByIndex(TagIndex).GetTagName()));
+	}
+
+	auto AppendMatches = [&State](TConstArrayView<const FElementalReactionRule*> Rules, int32 NumRules)
+	{
+		for (int32 MatchIndex = 0; MatchIndex < NumRules; ++MatchIndex)
+		{
+			const FElementalReactionRule& Rule = *Rules[MatchIndex];
+
+			FMatch Match;
+			Match.SourceTag = GetNameIndex(State, Rule.SourceTag.GetTagName());
+			Match.TargetTag = GetNameIndex(State, Rule.TargetTag.GetTagName());
+			Match.ReactionEffect = Rule.ReactionEffect ? GetNameIndex(State, Rule.ReactionEffect->GetFName()) : NoName;
+			Append(State.Buffer, Match);
+		}
+	};
+
+	AppendMatches(Matches, Record.NumMatches);
+	if (Record.NumApplied != AppliedUnknown)
+	{
+		AppendMatches(Applied, Record.NumApplied);
+	}
+
+	++State.NumRecords;
+
+	if (State.Buffer.Num() >= FlushThreshold)
+	{
+		FlushBuffer(State);
+	}
+}
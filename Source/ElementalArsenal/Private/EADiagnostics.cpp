@@ -0,0 +1,36 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "EADiagnostics.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_STAT(STAT_EA_RulesEvaluated);
+DEFINE_STAT(STAT_EA_ReactionsMatched);
+DEFINE_STAT(STAT_EA_ReactionsApplied);
+DEFINE_STAT(STAT_EA_ReactionsPropagated);
+DEFINE_STAT(STAT_EA_ReactionsSuppressed);
+DEFINE_STAT(STAT_EA_EquipsSync);
+DEFINE_STAT(STAT_EA_EquipsAsync);
+
+#if EA_WITH_DIAGNOSTICS
+
+namespace EADiagnostics
+{
+	static int32 DebugOverlay = 0;
+	static FAutoConsoleVariableRef CVarDebugOverlay(
+		TEXT("ea.Debug.Overlay"),
+		DebugOverlay,
+		TEXT("Show equip and reaction events on screen. 0: off (default), 1: on."));
+
+	bool IsOverlayEnabled()
+	{
+		return DebugOverlay != 0 && GEngine != nullptr;
+	}
+
+	void AddOverlayMessage(const FColor& Color, const FString& Message)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 5.0f, Color, Message);
+	}
+}
+
+#endif
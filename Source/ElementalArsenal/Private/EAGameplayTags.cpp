@@ -0,0 +1,48 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "EAGameplayTags.h"
+#include "ElementalArsenal.h"
+#include "GameplayTagsManager.h"
+
+FEAGameplayTags FEAGameplayTags::GameplayTags;
+
+void FEAGameplayTags::InitializeNativeTags()
+{
+	GameplayTags.AddAllTags();
+	GameplayTags.ValidateAllTags();
+}
+
+void FEAGameplayTags::AddAllTags()
+{
+	RegisteredTags.Reset();
+
+	AddTag(Effect_Reaction, "Effect.Reaction", "Tag added to reaction effects to prevent infinite recursion loops.");
+
+	AddTag(Element_Fire, "Element.Fire", "Fire element. Damage is reduced by FireResistance.");
+	AddTag(Element_Ice, "Element.Ice", "Ice element. Damage is reduced by IceResistance.");
+	AddTag(Element_Lightning, "Element.Lightning", "Lightning element. Damage is reduced by LightningResistance.");
+
+	AddTag(Equipment_Slot_MainHand, "Equipment.Slot.MainHand", "Main hand equipment slot. Default slot for definitions without one.");
+	AddTag(Equipment_Slot_OffHand, "Equipment.Slot.OffHand", "Off hand equipment slot.");
+	AddTag(Equipment_Slot_Armor, "Equipment.Slot.Armor", "Armor equipment slot.");
+	AddTag(Equipment_Slot_Trinket, "Equipment.Slot.Trinket", "Trinket equipment slot.");
+}
+
+void FEAGameplayTags::AddTag(FGameplayTag& OutTag, const ANSICHAR* TagName, const ANSICHAR* TagComment)
+{
+	const FName Name(TagName);
+	OutTag = UGameplayTagsManager::Get().AddNativeGameplayTag(Name, FString(TagComment));
+	RegisteredTags.Emplace(Name, &OutTag);
+}
+
+void FEAGameplayTags::ValidateAllTags() const
+{
+	for (const TPair<FName, const FGameplayTag*>& Entry : RegisteredTags)
+	{
+		// Fail at startup rather than silently skipping reactions mid-combat
+		if (!Entry.Value->IsValid() || Entry.Value->GetTagName() != Entry.Key)
+		{
+			UE_LOG(LogElementalArsenal, Fatal, TEXT("Native gameplay tag '%s' failed to register."), *Entry.Key.ToString());
+		}
+	}
+}
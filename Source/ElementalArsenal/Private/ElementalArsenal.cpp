@@ -1,7 +1,9 @@
 // Copyright NeoNexus Studios. All Rights Reserved.
 
 #include "ElementalArsenal.h"
-#include "GameplayTagsManager.h"
+#include "EAGameplayTags.h"
+#include "EACombatLog.h"
+#include "Misc/CoreDelegates.h"
 
 DEFINE_LOG_CATEGORY(LogElementalArsenal);
 
@@ -9,17 +11,19 @@ DEFINE_LOG_CATEGORY(LogElementalArsenal);
 
 void FElementalArsenalModule::StartupModule()
 {
-	// Register the Native Gameplay Tag for Recursion Guarding
-	UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Effect.Reaction"), 
-		FString("Tag added to reaction effects to prevent infinite recursion loops.")
-	);
+	// Register the plugin's Native Gameplay Tags (including Effect.Reaction for Recursion Guarding)
+	FEAGameplayTags::InitializeNativeTags();
+
+	// Finish a combat log left recording while the task system can still complete its writes
+	PreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&FEACombatRecorder::Stop);
 }
 
 void FElementalArsenalModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+	FEACombatRecorder::Stop();
 }
 
 #undef LOCTEXT_NAMESPACE
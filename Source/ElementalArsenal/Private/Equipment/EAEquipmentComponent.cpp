@@ -2,6 +2,8 @@
 
 #include "Equipment/EAEquipmentComponent.h"
 #include "Equipment/EAEquipmentDefinition.h"
+#include "Equipment/EAEquipmentPreloadSubsystem.h"
+#include "Equipment/EAEquipmentVisualPool.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemInterface.h"
 #include "GameFramework/Character.h"
@@ -9,24 +11,130 @@
 #include "Engine/StaticMesh.h"
 #include "Animation/SkeletalMeshActor.h"
 #include "Engine/StaticMeshActor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "Engine/AssetManager.h"
+#include "EAGameplayTags.h"
+#include "EADiagnostics.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "ElementalArsenal.h" // For Log Category
 
+DECLARE_CYCLE_STAT(TEXT("Equip Slot"), STAT_EA_EquipSlot, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Equip Gameplay Diff"), STAT_EA_ApplyGameplayDiff, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Spawn Equipment Visuals"), STAT_EA_SpawnEquipmentVisuals, STATGROUP_ElementalArsenal);
+
+void FEAReplicatedSlotEntry::PreReplicatedRemove(const FEAReplicatedSlotList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->OnSlotReplicated(SlotTag, FPrimaryAssetId());
+	}
+}
+
+void FEAReplicatedSlotEntry::PostReplicatedAdd(const FEAReplicatedSlotList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->OnSlotReplicated(SlotTag, ItemId);
+	}
+}
+
+void FEAReplicatedSlotEntry::PostReplicatedChange(const FEAReplicatedSlotList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->OnSlotReplicated(SlotTag, ItemId);
+	}
+}
+
+bool FEAReplicatedSlotList::SetSlot(const FGameplayTag& SlotTag, const FPrimaryAssetId& ItemId)
+{
+	for (FEAReplicatedSlotEntry& Entry : Entries)
+	{
+		if (Entry.SlotTag == SlotTag)
+		{
+			if (Entry.ItemId == ItemId)
+			{
+				return false;
+			}
+			Entry.ItemId = ItemId;
+			MarkItemDirty(Entry);
+			return true;
+		}
+	}
+
+	// Emptied slots keep their entry, so the list never grows past the number of slots used
+	FEAReplicatedSlotEntry& NewEntry = Entries.AddDefaulted_GetRef();
+	NewEntry.SlotTag = SlotTag;
+	NewEntry.ItemId = ItemId;
+	MarkItemDirty(NewEntry);
+	return true;
+}
+
+const FEAReplicatedSlotEntry* FEAReplicatedSlotList::FindSlot(const FGameplayTag& SlotTag) const
+{
+	return Entries.FindByPredicate([&SlotTag](const FEAReplicatedSlotEntry& Entry) { return Entry.SlotTag == SlotTag; });
+}
+
 UEAEquipmentComponent::UEAEquipmentComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
-	CurrentEquipmentDef = nullptr;
-	SpawnedEquipmentMesh = nullptr;
+	SetIsReplicatedByDefault(true);
+
+	ReplicatedSlots.OwnerComponent = this;
+}
+
+void UEAEquipmentComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UEAEquipmentComponent, ReplicatedSlots, Params);
 }
 
 void UEAEquipmentComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Slots received before BeginPlay were skipped in OnSlotReplicated
+	if (GetOwner() && !GetOwner()->HasAuthority())
+	{
+		for (const FEAReplicatedSlotEntry& Entry : ReplicatedSlots.Entries)
+		{
+			OnSlotReplicated(Entry.SlotTag, Entry.ItemId);
+		}
+	}
 }
 
 void UEAEquipmentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	UnequipItem();
+	// Local teardown only, nothing to replicate at this point
+	TArray<FGameplayTag> SlotTags;
+	EquippedSlots.GetKeys(SlotTags);
+	for (const FGameplayTag& SlotTag : SlotTags)
+	{
+		SetSlotItem(SlotTag, nullptr);
+	}
+
+	for (TPair<FGameplayTag, FEAEquippedSlot>& Pair : EquippedSlots)
+	{
+		if (Pair.Value.PendingDefinitionHandle.IsValid())
+		{
+			Pair.Value.PendingDefinitionHandle->CancelHandle();
+		}
+		if (Pair.Value.SkeletalVisualComponent)
+		{
+			Pair.Value.SkeletalVisualComponent->DestroyComponent();
+		}
+		if (Pair.Value.StaticVisualComponent)
+		{
+			Pair.Value.StaticVisualComponent->DestroyComponent();
+		}
+	}
+	EquippedSlots.Empty();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -48,45 +156,435 @@ void UEAEquipmentComponent::EquipItem(const UEAEquipmentDefinition* ItemDef)
 		return;
 	}
 
-	if (CurrentEquipmentDef == ItemDef)
+	EquipItemInSlot(ItemDef->GetEquipSlot(), ItemDef);
+}
+
+void UEAEquipmentComponent::EquipItemInSlot(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef)
+{
+	if (!SlotTag.IsValid())
+	{
+		SlotTag = ItemDef ? ItemDef->GetEquipSlot() : FEAGameplayTags::Get().Equipment_Slot_MainHand;
+	}
+
+	if (!ItemDef)
+	{
+		UnequipSlot(SlotTag);
+		return;
+	}
+
+	if (!CanModifyEquipment(TEXT("EquipItemInSlot")))
+	{
+		return;
+	}
+
+	SetSlotItem(SlotTag, ItemDef);
+	ReplicateSlot(SlotTag, ItemDef);
+}
+
+void UEAEquipmentComponent::UnequipItem()
+{
+	if (!CanModifyEquipment(TEXT("UnequipItem")))
+	{
+		return;
+	}
+
+	TArray<FGameplayTag> SlotTags;
+	EquippedSlots.GetKeys(SlotTags);
+
+	for (const FGameplayTag& SlotTag : SlotTags)
+	{
+		UnequipSlot(SlotTag);
+	}
+}
+
+void UEAEquipmentComponent::UnequipSlot(FGameplayTag SlotTag)
+{
+	if (!CanModifyEquipment(TEXT("UnequipSlot")))
+	{
+		return;
+	}
+
+	SetSlotItem(SlotTag, nullptr);
+	ReplicateSlot(SlotTag, nullptr);
+}
+
+bool UEAEquipmentComponent::CanModifyEquipment(const TCHAR* Context) const
+{
+	const AActor* Owner = GetOwner();
+	if (Owner && !Owner->HasAuthority())
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("%s: Equipment is server authoritative, ignoring call on client for %s"), Context, *Owner->GetName());
+		return false;
+	}
+	return true;
+}
+
+void UEAEquipmentComponent::SetSlotItem(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_EquipSlot);
+
+	FEAEquippedSlot* ExistingSlot = EquippedSlots.Find(SlotTag);
+	if (!ItemDef && (!ExistingSlot || !ExistingSlot->ItemDef))
+	{
+		return; // Nothing to unequip
+	}
+
+	FEAEquippedSlot& Slot = ExistingSlot ? *ExistingSlot : EquippedSlots.Add(SlotTag);
+	if (Slot.ItemDef == ItemDef)
 	{
 		return; // Already equipped
 	}
 
-	UnequipItem(); // Clean up old item
-	CurrentEquipmentDef = ItemDef;
+	// 1. Remove Visuals of the old item (and stop streaming them if they are still loading)
+	const UEAEquipmentDefinition* OldDef = Slot.ItemDef;
+	ReleaseSlotVisuals(Slot);
+	Slot.ItemDef = ItemDef;
+
+	if (!ItemDef)
+	{
+		// 2. Remove Gameplay (Abilities & Tags)
+		ApplyGameplayDiff(OldDef, nullptr);
+		return;
+	}
+
+	// DEBUG ON SCREEN (ea.Debug.Overlay)
+	EA_DEBUG_OVERLAY(FColor::Green, TEXT("Equipping Item: %s"), *ItemDef->GetName());
+
+	if (UEAEquipmentPreloadSubsystem* Preload = UEAEquipmentPreloadSubsystem::Get(this))
+	{
+		Preload->NotifyEquipped(ItemDef);
+	}
+
+	// 2. Gameplay: Grant Abilities & Tags right away, they do not depend on the mesh
+	ApplyGameplayDiff(OldDef, ItemDef);
+
+	// 3. Visuals
+	LoadSlotVisuals(SlotTag);
+}
+
+void UEAEquipmentComponent::ReplicateSlot(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef)
+{
+	FPrimaryAssetId ItemId;
+	if (ItemDef)
+	{
+		ItemId = ItemDef->GetPrimaryAssetId();
+		if (!ItemId.IsValid())
+		{
+			UE_LOG(LogElementalArsenal, Warning, TEXT("EquipItem: %s has no Primary Asset Id, clients will not see it. Is EAEquipmentDefinition in the Asset Manager's Primary Asset Types?"), *ItemDef->GetName());
+		}
+	}
+
+	if (ReplicatedSlots.SetSlot(SlotTag, ItemId))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UEAEquipmentComponent, ReplicatedSlots, this);
+	}
+}
+
+void UEAEquipmentComponent::OnSlotReplicated(FGameplayTag SlotTag, const FPrimaryAssetId& ItemId)
+{
+	if (!HasBegunPlay())
+	{
+		return; // BeginPlay applies everything received so far
+	}
+
+	// A newer id supersedes any definition still loading for this slot
+	if (FEAEquippedSlot* Slot = EquippedSlots.Find(SlotTag))
+	{
+		if (Slot->PendingDefinitionHandle.IsValid())
+		{
+			Slot->PendingDefinitionHandle->CancelHandle();
+			Slot->PendingDefinitionHandle.Reset();
+		}
+	}
+
+	if (!ItemId.IsValid())
+	{
+		SetSlotItem(SlotTag, nullptr);
+		return;
+	}
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	const FSoftObjectPath ItemPath = AssetManager ? AssetManager->GetPrimaryAssetPath(ItemId) : FSoftObjectPath();
+	if (ItemPath.IsNull())
+	{
+		UE_LOG(LogElementalArsenal, Error, TEXT("EquipItem: Could not resolve replicated item %s"), *ItemId.ToString());
+		return;
+	}
+
+	if (const UEAEquipmentDefinition* ItemDef = Cast<UEAEquipmentDefinition>(ItemPath.ResolveObject()))
+	{
+		SetSlotItem(SlotTag, ItemDef);
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = AssetManager->GetStreamableManager().RequestAsyncLoad(
+		ItemPath,
+		FStreamableDelegate::CreateUObject(this, &UEAEquipmentComponent::OnReplicatedItemLoaded, SlotTag, ItemId));
+
+	// The callback may already have run if the definition was resident after all
+	if (Handle.IsValid() && !Handle->HasLoadCompleted())
+	{
+		EquippedSlots.FindOrAdd(SlotTag).PendingDefinitionHandle = Handle;
+	}
+}
+
+void UEAEquipmentComponent::OnReplicatedItemLoaded(FGameplayTag SlotTag, FPrimaryAssetId ItemId)
+{
+	const FEAReplicatedSlotEntry* Entry = ReplicatedSlots.FindSlot(SlotTag);
+	if (!Entry || Entry->ItemId != ItemId)
+	{
+		return; // Stale load
+	}
+
+	const FSoftObjectPath ItemPath = UAssetManager::Get().GetPrimaryAssetPath(ItemId);
+	SetSlotItem(SlotTag, Cast<UEAEquipmentDefinition>(ItemPath.ResolveObject()));
+
+	// The slot's ItemDef keeps the definition alive from here on
+	if (FEAEquippedSlot* Slot = EquippedSlots.Find(SlotTag))
+	{
+		Slot->PendingDefinitionHandle.Reset();
+	}
+}
+
+void UEAEquipmentComponent::ApplyGameplayDiff(const UEAEquipmentDefinition* OldDef, const UEAEquipmentDefinition* NewDef)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ApplyGameplayDiff);
+
+	UAbilitySystemComponent* ASC = GetAbilitySystemComponent();
+	if (!ASC) return;
+
+	// Loose tags are not replicated, so every machine applies them. Abilities only on the server.
+	const bool bHasAuthority = GetOwner() && GetOwner()->HasAuthority();
+
+	// Abilities: grant what is new, release what is gone. Ref counts cover the same ability in several slots.
+	TArray<const UClass*, TInlineAllocator<8>> OldAbilities;
+	TArray<const UClass*, TInlineAllocator<8>> NewAbilities;
+	if (OldDef && bHasAuthority)
+	{
+		for (const TSubclassOf<UGameplayAbility>& AbilityClass : OldDef->AbilitiesToGrant)
+		{
+			if (AbilityClass)
+			{
+				OldAbilities.AddUnique(AbilityClass.Get());
+			}
+		}
+	}
+	if (NewDef && bHasAuthority)
+	{
+		for (const TSubclassOf<UGameplayAbility>& AbilityClass : NewDef->AbilitiesToGrant)
+		{
+			if (AbilityClass)
+			{
+				NewAbilities.AddUnique(AbilityClass.Get());
+			}
+		}
+	}
+
+	for (const UClass* AbilityClass : NewAbilities)
+	{
+		if (OldAbilities.Contains(AbilityClass))
+		{
+			continue;
+		}
+
+		FGrantedAbility& Granted = GrantedAbilities.FindOrAdd(AbilityClass);
+		if (Granted.RefCount++ == 0)
+		{
+			FGameplayAbilitySpec Spec(const_cast<UClass*>(AbilityClass), 1, INDEX_NONE, this);
+			Granted.Handle = ASC->GiveAbility(Spec);
+		}
+	}
+
+	for (const UClass* AbilityClass : OldAbilities)
+	{
+		if (NewAbilities.Contains(AbilityClass))
+		{
+			continue;
+		}
+
+		FGrantedAbility* Granted = GrantedAbilities.Find(AbilityClass);
+		if (Granted && --Granted->RefCount <= 0)
+		{
+			ASC->ClearAbility(Granted->Handle);
+			GrantedAbilities.Remove(AbilityClass);
+		}
+	}
+
+	// Loose tags are counted by the ASC, so only the exact differences need to change
+	const FGameplayTagContainer EmptyTags;
+	const FGameplayTagContainer& OldTags = OldDef ? OldDef->EquipmentTags : EmptyTags;
+	const FGameplayTagContainer& NewTags = NewDef ? NewDef->EquipmentTags : EmptyTags;
+
+	FGameplayTagContainer TagsToAdd;
+	for (const FGameplayTag& Tag : NewTags)
+	{
+		if (!OldTags.HasTagExact(Tag))
+		{
+			TagsToAdd.AddTag(Tag);
+		}
+	}
+
+	FGameplayTagContainer TagsToRemove;
+	for (const FGameplayTag& Tag : OldTags)
+	{
+		if (!NewTags.HasTagExact(Tag))
+		{
+			TagsToRemove.AddTag(Tag);
+		}
+	}
+
+	if (!TagsToAdd.IsEmpty())
+	{
+		ASC->AddLooseGameplayTags(TagsToAdd);
+	}
+	if (!TagsToRemove.IsEmpty())
+	{
+		ASC->RemoveLooseGameplayTags(TagsToRemove);
+	}
+}
+
+void UEAEquipmentComponent::LoadSlotVisuals(FGameplayTag SlotTag)
+{
+	FEAEquippedSlot& Slot = EquippedSlots.FindChecked(SlotTag);
+	const UEAEquipmentDefinition* ItemDef = Slot.ItemDef;
+
+	// Spawn now if the mesh is resident, otherwise stream it in
+	TArray<FSoftObjectPath> MeshesToLoad;
+	if (!ItemDef->MeshToSpawn.IsNull() && !ItemDef->MeshToSpawn.IsValid())
+	{
+		MeshesToLoad.Add(ItemDef->MeshToSpawn.ToSoftObjectPath());
+	}
+	else if (ItemDef->MeshToSpawn.IsNull() && !ItemDef->StaticMeshToSpawn.IsNull() && !ItemDef->StaticMeshToSpawn.IsValid())
+	{
+		MeshesToLoad.Add(ItemDef->StaticMeshToSpawn.ToSoftObjectPath());
+	}
+
+	if (MeshesToLoad.Num() == 0)
+	{
+		INC_DWORD_STAT(STAT_EA_EquipsSync);
+		SpawnEquipmentVisuals(SlotTag);
+	}
+	else if (bLoadVisualsAsync)
+	{
+		INC_DWORD_STAT(STAT_EA_EquipsAsync);
+		TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			MeshesToLoad,
+			FStreamableDelegate::CreateUObject(this, &UEAEquipmentComponent::OnVisualsLoaded, SlotTag, ItemDef, false));
 
-	// DEBUG ON SCREEN
-	if (GEngine)
+		// The callback may already have run if the mesh was resident after all
+		if (Handle.IsValid() && !Handle->HasLoadCompleted())
+		{
+			EquippedSlots.FindChecked(SlotTag).PendingVisualsHandle = Handle;
+		}
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_EA_EquipsSync);
+		UAssetManager::GetStreamableManager().RequestSyncLoad(MeshesToLoad);
+
+		// The skeletal mesh failed to load: fall back to the static mesh like an unset one would
+		if (NeedsStaticMeshFallback(ItemDef))
+		{
+			UAssetManager::GetStreamableManager().RequestSyncLoad(ItemDef->StaticMeshToSpawn.ToSoftObjectPath());
+		}
+		SpawnEquipmentVisuals(SlotTag);
+	}
+}
+
+bool UEAEquipmentComponent::NeedsStaticMeshFallback(const UEAEquipmentDefinition* ItemDef)
+{
+	return !ItemDef->MeshToSpawn.IsNull() && !ItemDef->MeshToSpawn.IsValid()
+		&& !ItemDef->StaticMeshToSpawn.IsNull() && !ItemDef->StaticMeshToSpawn.IsValid();
+}
+
+void UEAEquipmentComponent::OnVisualsLoaded(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef, bool bFallback)
+{
+	// A swap mid-load cancels the handle, but guard against a stale callback anyway
+	FEAEquippedSlot* Slot = EquippedSlots.Find(SlotTag);
+	if (!Slot || Slot->ItemDef != ItemDef)
+	{
+		return;
+	}
+
+	// The skeletal mesh failed to load: stream the static mesh fallback once before spawning
+	if (!bFallback && NeedsStaticMeshFallback(ItemDef))
+	{
+		TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			ItemDef->StaticMeshToSpawn.ToSoftObjectPath(),
+			FStreamableDelegate::CreateUObject(this, &UEAEquipmentComponent::OnVisualsLoaded, SlotTag, ItemDef, true));
+		if (Handle.IsValid())
+		{
+			// The callback spawns once the fallback arrives; keep the handle cancellable on a swap
+			if (!Handle->HasLoadCompleted())
+			{
+				EquippedSlots.FindChecked(SlotTag).PendingVisualsHandle = Handle;
+			}
+			return;
+		}
+	}
+
+	SpawnEquipmentVisuals(SlotTag);
+
+	// Release after spawning: the spawned component now references the mesh
+	EquippedSlots.FindChecked(SlotTag).PendingVisualsHandle.Reset();
+}
+
+bool UEAEquipmentComponent::IsLoadingVisuals() const
+{
+	for (const TPair<FGameplayTag, FEAEquippedSlot>& Pair : EquippedSlots)
 	{
-		FString DebugMsg = FString::Printf(TEXT("Equipping Item: %s"), *ItemDef->GetName());
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, DebugMsg);
+		if (Pair.Value.PendingVisualsHandle.IsValid())
+		{
+			return true;
+		}
 	}
+	return false;
+}
+
+void UEAEquipmentComponent::SpawnEquipmentVisuals(FGameplayTag SlotTag)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_SpawnEquipmentVisuals);
 
 	AActor* Owner = GetOwner();
 	if (!Owner) return;
 
+	FEAEquippedSlot& Slot = EquippedSlots.FindChecked(SlotTag);
+	const UEAEquipmentDefinition* ItemDef = Slot.ItemDef;
+
+	if (VisualMode == EEAEquipmentVisualMode::Component)
+	{
+		AttachVisualComponent(Slot);
+		return;
+	}
+
+	// Pooled actors come pre-configured; without a pool (e.g. editor worlds) spawn a fresh one
+	UEAEquipmentVisualPool* VisualPool = UWorld::GetSubsystem<UEAEquipmentVisualPool>(GetWorld());
+
 	// Prepare Spawn Params
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	SpawnParams.Owner = Owner;
 
-	// 1. Visuals: Spawn the Mesh
 	// Option A: Skeletal Mesh
-
-	if (USkeletalMesh* SkelMeshAsset = ItemDef->MeshToSpawn.LoadSynchronous())
+	if (USkeletalMesh* SkelMeshAsset = ItemDef->MeshToSpawn.Get())
 	{
-		ASkeletalMeshActor* NewActor = GetWorld()->SpawnActor<ASkeletalMeshActor>(ASkeletalMeshActor::StaticClass(), FTransform::Identity, SpawnParams);
+		ASkeletalMeshActor* NewActor = VisualPool
+			? VisualPool->AcquireSkeletalMeshActor(Owner)
+			: GetWorld()->SpawnActor<ASkeletalMeshActor>(ASkeletalMeshActor::StaticClass(), FTransform::Identity, SpawnParams);
 		if (NewActor)
 		{
 			NewActor->GetSkeletalMeshComponent()->SetSkeletalMesh(SkelMeshAsset);
-			NewActor->GetSkeletalMeshComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
-			NewActor->GetSkeletalMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			NewActor->GetSkeletalMeshComponent()->SetGenerateOverlapEvents(false); // <--- NUCLEAR OPTION
-			NewActor->SetActorEnableCollision(false);
-			
-			SpawnedEquipmentMesh = NewActor;
-			UE_LOG(LogElementalArsenal, Log, TEXT("EquipItem: Spawned SkeletalMeshActor %s"), *NewActor->GetName());
+			if (!VisualPool)
+			{
+				NewActor->GetSkeletalMeshComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+				NewActor->GetSkeletalMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+				NewActor->GetSkeletalMeshComponent()->SetGenerateOverlapEvents(false); // <--- NUCLEAR OPTION
+				NewActor->SetActorEnableCollision(false);
+				NewActor->SetReplicates(false);
+			}
+
+			Slot.SpawnedActor = NewActor;
+			UE_LOG(LogElementalArsenal, Verbose, TEXT("EquipItem: Spawned SkeletalMeshActor %s"), *NewActor->GetName());
 		}
 		else
 		{
@@ -96,18 +594,25 @@ void UEAEquipmentComponent::EquipItem(const UEAEquipmentDefinition* ItemDef)
 	// Option B: Static Mesh (Fallback)
 	else
 	{
-		if (UStaticMesh* StaticMeshAsset = ItemDef->StaticMeshToSpawn.LoadSynchronous())
+		if (UStaticMesh* StaticMeshAsset = ItemDef->StaticMeshToSpawn.Get())
 		{
-			if (AStaticMeshActor* NewActor = GetWorld()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform::Identity, SpawnParams))
+			AStaticMeshActor* NewActor = VisualPool
+				? VisualPool->AcquireStaticMeshActor(Owner)
+				: GetWorld()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform::Identity, SpawnParams);
+			if (NewActor)
 			{
 				NewActor->GetStaticMeshComponent()->SetStaticMesh(StaticMeshAsset);
-				NewActor->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
-				NewActor->GetStaticMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-				NewActor->GetStaticMeshComponent()->SetGenerateOverlapEvents(false); // <--- NUCLEAR OPTION
-				NewActor->SetActorEnableCollision(false);
-				
-				SpawnedEquipmentMesh = NewActor;
-				UE_LOG(LogElementalArsenal, Log, TEXT("EquipItem: Spawned StaticMeshActor %s"), *NewActor->GetName());
+				if (!VisualPool)
+				{
+					NewActor->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+					NewActor->GetStaticMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+					NewActor->GetStaticMeshComponent()->SetGenerateOverlapEvents(false); // <--- NUCLEAR OPTION
+					NewActor->SetActorEnableCollision(false);
+					NewActor->SetReplicates(false);
+				}
+
+				Slot.SpawnedActor = NewActor;
+				UE_LOG(LogElementalArsenal, Verbose, TEXT("EquipItem: Spawned StaticMeshActor %s"), *NewActor->GetName());
 			}
 		}
 		else
@@ -117,73 +622,176 @@ void UEAEquipmentComponent::EquipItem(const UEAEquipmentDefinition* ItemDef)
 	}
 
 	// Attach whatever we spawned
-	if (SpawnedEquipmentMesh)
+	if (AActor* SpawnedActor = Slot.SpawnedActor)
 	{
 		bool bAttached = false;
 		if (ACharacter* Char = Cast<ACharacter>(Owner))
 		{
-			bAttached = SpawnedEquipmentMesh->AttachToComponent(Char->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, ItemDef->AttachSocketName);
+			bAttached = SpawnedActor->AttachToComponent(Char->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, ItemDef->AttachSocketName);
 		}
 		else
 		{
-			bAttached = SpawnedEquipmentMesh->AttachToActor(Owner, FAttachmentTransformRules::SnapToTargetNotIncludingScale, ItemDef->AttachSocketName);
+			bAttached = SpawnedActor->AttachToActor(Owner, FAttachmentTransformRules::SnapToTargetNotIncludingScale, ItemDef->AttachSocketName);
 		}
 
 		if (bAttached)
 		{
-			UE_LOG(LogElementalArsenal, Log, TEXT("EquipItem: Attached %s to socket %s"), *SpawnedEquipmentMesh->GetName(), *ItemDef->AttachSocketName.ToString());
+			UE_LOG(LogElementalArsenal, Verbose, TEXT("EquipItem: Attached %s to socket %s"), *SpawnedActor->GetName(), *ItemDef->AttachSocketName.ToString());
 		}
 		else
 		{
-			UE_LOG(LogElementalArsenal, Error, TEXT("EquipItem: Failed to attach %s to socket %s. Check if socket exists!"), *SpawnedEquipmentMesh->GetName(), *ItemDef->AttachSocketName.ToString());
+			UE_LOG(LogElementalArsenal, Error, TEXT("EquipItem: Failed to attach %s to socket %s. Check if socket exists!"), *SpawnedActor->GetName(), *ItemDef->AttachSocketName.ToString());
 		}
+
+		OnEquipmentVisualsReady.Broadcast(ItemDef, SpawnedActor, GetEquipmentMeshComponent(SlotTag));
 	}
+}
 
-	// 2. Gameplay: Grant Abilities & Tags
-	if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+void UEAEquipmentComponent::AttachVisualComponent(FEAEquippedSlot& Slot)
+{
+	AActor* Owner = GetOwner();
+	USceneComponent* AttachParent = GetVisualAttachParent();
+	const UEAEquipmentDefinition* ItemDef = Slot.ItemDef;
+	if (!Owner || !AttachParent) return;
+
+	// Option A: Skeletal Mesh
+	if (USkeletalMesh* SkelMeshAsset = ItemDef->MeshToSpawn.Get())
 	{
-		// Grant Abilities
-		for (TSubclassOf<UGameplayAbility> AbilityClass : ItemDef->AbilitiesToGrant)
+		if (!Slot.SkeletalVisualComponent)
 		{
-			if (AbilityClass)
-			{
-				FGameplayAbilitySpec Spec(AbilityClass, 1, INDEX_NONE, this);
-				// Add Tags to Source Object (not dynamic tags, as that API changed, simpler to just rely on Owner Tags)
-				
-				FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(Spec);
-				GrantedAbilityHandles.Add(Handle);
-			}
+			Slot.SkeletalVisualComponent = NewObject<USkeletalMeshComponent>(Owner, NAME_None, RF_Transient);
+			InitVisualComponent(Slot.SkeletalVisualComponent);
+			Slot.SkeletalVisualComponent->RegisterComponent();
+		}
+
+		Slot.SkeletalVisualComponent->SetSkeletalMesh(SkelMeshAsset);
+		Slot.ActiveVisualComponent = Slot.SkeletalVisualComponent;
+	}
+	// Option B: Static Mesh (Fallback)
+	else if (UStaticMesh* StaticMeshAsset = ItemDef->StaticMeshToSpawn.Get())
+	{
+		if (!Slot.StaticVisualComponent)
+		{
+			Slot.StaticVisualComponent = NewObject<UStaticMeshComponent>(Owner, NAME_None, RF_Transient);
+			InitVisualComponent(Slot.StaticVisualComponent);
+			Slot.StaticVisualComponent->RegisterComponent();
 		}
 
-		// Apply Loose Tags
-		ASC->AddLooseGameplayTags(ItemDef->EquipmentTags);
+		Slot.StaticVisualComponent->SetStaticMesh(StaticMeshAsset);
+		Slot.ActiveVisualComponent = Slot.StaticVisualComponent;
+	}
+	else
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("EquipItem: No Mesh found in Definition for %s"), *ItemDef->GetName());
+		return;
+	}
+
+	UMeshComponent* VisualComponent = Slot.ActiveVisualComponent;
+	if (!VisualComponent->AttachToComponent(AttachParent, FAttachmentTransformRules::SnapToTargetNotIncludingScale, ItemDef->AttachSocketName))
+	{
+		UE_LOG(LogElementalArsenal, Error, TEXT("EquipItem: Failed to attach %s to socket %s. Check if socket exists!"), *VisualComponent->GetName(), *ItemDef->AttachSocketName.ToString());
 	}
+
+	VisualComponent->SetComponentTickEnabled(bTickVisualComponent);
+	VisualComponent->SetVisibility(true);
+
+	OnEquipmentVisualsReady.Broadcast(ItemDef, nullptr, VisualComponent);
 }
 
-void UEAEquipmentComponent::UnequipItem()
+void UEAEquipmentComponent::ReleaseSlotVisuals(FEAEquippedSlot& Slot)
 {
-	if (!CurrentEquipmentDef) return;
+	if (Slot.PendingVisualsHandle.IsValid())
+	{
+		Slot.PendingVisualsHandle->CancelHandle();
+		Slot.PendingVisualsHandle.Reset();
+	}
 
-	// 1. Remove Visuals
-	if (SpawnedEquipmentMesh)
+	if (Slot.SpawnedActor)
 	{
-		SpawnedEquipmentMesh->Destroy();
-		SpawnedEquipmentMesh = nullptr;
+		if (UEAEquipmentVisualPool* VisualPool = UWorld::GetSubsystem<UEAEquipmentVisualPool>(GetWorld()))
+		{
+			VisualPool->ReleaseActor(Slot.SpawnedActor);
+		}
+		else
+		{
+			Slot.SpawnedActor->Destroy();
+		}
+		Slot.SpawnedActor = nullptr;
 	}
 
-	// 2. Remove Gameplay (Abilities & Tags)
-	if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+	// Component mode: hide and keep the component for the next equip
+	if (UMeshComponent* VisualComponent = Slot.ActiveVisualComponent)
 	{
-		// Remove Abilities
-		for (FGameplayAbilitySpecHandle Handle : GrantedAbilityHandles)
+		VisualComponent->SetVisibility(false);
+		VisualComponent->SetComponentTickEnabled(false);
+		if (USkeletalMeshComponent* SkeletalComponent = Cast<USkeletalMeshComponent>(VisualComponent))
+		{
+			SkeletalComponent->SetSkeletalMesh(nullptr);
+		}
+		else if (UStaticMeshComponent* StaticComponent = Cast<UStaticMeshComponent>(VisualComponent))
 		{
-			ASC->ClearAbility(Handle);
+			StaticComponent->SetStaticMesh(nullptr);
 		}
-		GrantedAbilityHandles.Empty();
+		Slot.ActiveVisualComponent = nullptr;
+	}
+}
+
+void UEAEquipmentComponent::InitVisualComponent(UMeshComponent* MeshComponent) const
+{
+	MeshComponent->SetMobility(EComponentMobility::Movable);
+	MeshComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComponent->SetGenerateOverlapEvents(false);
+	MeshComponent->PrimaryComponentTick.bStartWithTickEnabled = bTickVisualComponent;
+}
 
-		// Remove Loose Tags
-		ASC->RemoveLooseGameplayTags(CurrentEquipmentDef->EquipmentTags);
+USceneComponent* UEAEquipmentComponent::GetVisualAttachParent() const
+{
+	AActor* Owner = GetOwner();
+	if (ACharacter* Char = Cast<ACharacter>(Owner))
+	{
+		return Char->GetMesh();
 	}
+	return Owner ? Owner->GetRootComponent() : nullptr;
+}
 
-	CurrentEquipmentDef = nullptr;
-}
\ No newline at end of file
+const UEAEquipmentDefinition* UEAEquipmentComponent::GetEquippedItem(FGameplayTag SlotTag) const
+{
+	const FEAEquippedSlot* Slot = EquippedSlots.Find(SlotTag);
+	return Slot ? Slot->ItemDef.Get() : nullptr;
+}
+
+AActor* UEAEquipmentComponent::GetSpawnedEquipmentActor() const
+{
+	return GetSpawnedEquipmentActorInSlot(FEAGameplayTags::Get().Equipment_Slot_MainHand);
+}
+
+AActor* UEAEquipmentComponent::GetSpawnedEquipmentActorInSlot(FGameplayTag SlotTag) const
+{
+	const FEAEquippedSlot* Slot = EquippedSlots.Find(SlotTag);
+	return Slot ? Slot->SpawnedActor.Get() : nullptr;
+}
+
+UMeshComponent* UEAEquipmentComponent::GetEquipmentMeshComponent(FGameplayTag SlotTag) const
+{
+	const FEAEquippedSlot* Slot = EquippedSlots.Find(SlotTag);
+	if (!Slot)
+	{
+		return nullptr;
+	}
+
+	if (Slot->ActiveVisualComponent)
+	{
+		return Slot->ActiveVisualComponent;
+	}
+
+	if (ASkeletalMeshActor* SkeletalActor = Cast<ASkeletalMeshActor>(Slot->SpawnedActor))
+	{
+		return SkeletalActor->GetSkeletalMeshComponent();
+	}
+	if (AStaticMeshActor* StaticActor = Cast<AStaticMeshActor>(Slot->SpawnedActor))
+	{
+		return StaticActor->GetStaticMeshComponent();
+	}
+	return nullptr;
+}
@@ -0,0 +1,9 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Equipment/EAEquipmentDefinition.h"
+#include "EAGameplayTags.h"
+
+FGameplayTag UEAEquipmentDefinition::GetEquipSlot() const
+{
+	return EquipSlot.IsValid() ? EquipSlot : FEAGameplayTags::Get().Equipment_Slot_MainHand;
+}
@@ -0,0 +1,251 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Equipment/EAEquipmentPreloadSubsystem.h"
+#include "Equipment/EAEquipmentDefinition.h"
+#include "EAReactionSettings.h"
+#include "ElementalArsenal.h"
+#include "EADiagnostics.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Preload Loadout"), STAT_EA_PreloadLoadout, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Preload Enforce Budget"), STAT_EA_PreloadEnforceBudget, STATGROUP_ElementalArsenal);
+
+namespace EAEquipmentPreload
+{
+	// Runs Delegate once Handle has loaded. Assets that are already resident complete inside RequestAsyncLoad, before
+	// the caller has stored the handle, so the delegate is bound afterwards or run right away.
+	static void WhenLoaded(const TSharedPtr<FStreamableHandle>& Handle, FStreamableDelegate Delegate)
+	{
+		if (Handle.IsValid() && !Handle->HasLoadCompleted() && Handle->BindCompleteDelegate(Delegate))
+		{
+			return;
+		}
+		Delegate.ExecuteIfBound();
+	}
+}
+
+void UEAEquipmentPreloadSubsystem::Deinitialize()
+{
+	ReleaseAll();
+	Super::Deinitialize();
+}
+
+UEAEquipmentPreloadSubsystem* UEAEquipmentPreloadSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? UGameInstance::GetSubsystem<UEAEquipmentPreloadSubsystem>(World->GetGameInstance()) : nullptr;
+}
+
+void UEAEquipmentPreloadSubsystem::PreloadLoadout(const TArray<TSoftObjectPtr<UEAEquipmentDefinition>>& Loadout)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_PreloadLoadout);
+
+	for (const TSoftObjectPtr<UEAEquipmentDefinition>& Definition : Loadout)
+	{
+		if (Definition.IsNull())
+		{
+			continue;
+		}
+
+		const FSoftObjectPath DefinitionPath = Definition.ToSoftObjectPath();
+		if (FPreloadEntry* Existing = Entries.Find(DefinitionPath))
+		{
+			Existing->LastUsed = ++UseCounter;
+			continue;
+		}
+
+		// The definition first; its meshes are only known once it is loaded
+		FPreloadEntry& Entry = Entries.Add(DefinitionPath);
+		Entry.LastUsed = ++UseCounter;
+		Entry.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(DefinitionPath, FStreamableDelegate(), FStreamableManager::AsyncLoadLowPriority);
+
+		EAEquipmentPreload::WhenLoaded(Entry.Handle, FStreamableDelegate::CreateUObject(this, &UEAEquipmentPreloadSubsystem::OnDefinitionLoaded, DefinitionPath));
+	}
+}
+
+void UEAEquipmentPreloadSubsystem::OnDefinitionLoaded(FSoftObjectPath DefinitionPath)
+{
+	FPreloadEntry* Entry = Entries.Find(DefinitionPath);
+	if (!Entry)
+	{
+		return;
+	}
+
+	const UEAEquipmentDefinition* ItemDef = Cast<UEAEquipmentDefinition>(DefinitionPath.ResolveObject());
+	if (!ItemDef)
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("Equipment preload: could not load %s."), *DefinitionPath.ToString());
+		RemoveEntry(DefinitionPath);
+		return;
+	}
+
+	// The definition again, so the new handle keeps it resident, then its meshes. Ability classes are hard references
+	// loaded with the definition; listing them keeps them resident and counts them against the budget.
+	TArray<FSoftObjectPath> AssetsToLoad;
+	AssetsToLoad.Add(DefinitionPath);
+	if (!ItemDef->MeshToSpawn.IsNull())
+	{
+		AssetsToLoad.Add(ItemDef->MeshToSpawn.ToSoftObjectPath());
+	}
+	if (!ItemDef->StaticMeshToSpawn.IsNull())
+	{
+		AssetsToLoad.Add(ItemDef->StaticMeshToSpawn.ToSoftObjectPath());
+	}
+	for (const TSubclassOf<UGameplayAbility>& AbilityClass : ItemDef->AbilitiesToGrant)
+	{
+		if (AbilityClass)
+		{
+			AssetsToLoad.Add(FSoftObjectPath(AbilityClass.Get()));
+		}
+	}
+
+	// Release the definition handle only after the new one references the definition
+	const TSharedPtr<FStreamableHandle> DefinitionHandle = MoveTemp(Entry->Handle);
+	Entry->Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate(), FStreamableManager::AsyncLoadLowPriority);
+	if (DefinitionHandle.IsValid())
+	{
+		DefinitionHandle->ReleaseHandle();
+	}
+
+	EAEquipmentPreload::WhenLoaded(Entry->Handle, FStreamableDelegate::CreateUObject(this, &UEAEquipmentPreloadSubsystem::OnEntryLoaded, DefinitionPath));
+}
+
+void UEAEquipmentPreloadSubsystem::OnEntryLoaded(FSoftObjectPath DefinitionPath)
+{
+	FPreloadEntry* Entry = Entries.Find(DefinitionPath);
+	if (!Entry || !Entry->Handle.IsValid() || !Entry->Handle->HasLoadCompleted() || Entry->bResident)
+	{
+		return;
+	}
+
+	Entry->Bytes = EstimateBytes(*Entry->Handle);
+	Entry->bResident = true;
+	Stats.ResidentBytes += Entry->Bytes;
+	++Stats.NumResident;
+
+	EnforceBudget(DefinitionPath);
+}
+
+void UEAEquipmentPreloadSubsystem::EnforceBudget(const FSoftObjectPath& KeepPath)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_PreloadEnforceBudget);
+
+	const int64 BudgetBytes = static_cast<int64>(GetDefault<UEAReactionSettings>()->EquipmentPreloadBudgetMB * 1024.0 * 1024.0);
+
+	while (Stats.ResidentBytes > BudgetBytes)
+	{
+		// Linear scan is fine, loadouts hold a handful of entries
+		const FSoftObjectPath* OldestPath = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FSoftObjectPath, FPreloadEntry>& Pair : Entries)
+		{
+			if (Pair.Key != KeepPath && Pair.Value.bResident && Pair.Value.LastUsed < OldestUse)
+			{
+				OldestPath = &Pair.Key;
+				OldestUse = Pair.Value.LastUsed;
+			}
+		}
+
+		if (!OldestPath)
+		{
+			UE_LOG(LogElementalArsenal, Warning, TEXT("Equipment preload: %s alone exceeds the %.1f MB budget."), *KeepPath.ToString(), GetDefault<UEAReactionSettings>()->EquipmentPreloadBudgetMB);
+			break;
+		}
+
+		const FSoftObjectPath EvictPath = *OldestPath;
+		RemoveEntry(EvictPath);
+		++Stats.Evictions;
+	}
+}
+
+void UEAEquipmentPreloadSubsystem::ReleaseDefinition(const UEAEquipmentDefinition* ItemDef)
+{
+	if (ItemDef)
+	{
+		RemoveEntry(FSoftObjectPath(ItemDef));
+	}
+}
+
+void UEAEquipmentPreloadSubsystem::ReleaseAll()
+{
+	for (TPair<FSoftObjectPath, FPreloadEntry>& Pair : Entries)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->ReleaseHandle();
+		}
+	}
+
+	Entries.Reset();
+	Stats.NumResident = 0;
+	Stats.ResidentBytes = 0;
+}
+
+void UEAEquipmentPreloadSubsystem::RemoveEntry(const FSoftObjectPath& DefinitionPath)
+{
+	FPreloadEntry Entry;
+	if (Entries.RemoveAndCopyValue(DefinitionPath, Entry))
+	{
+		if (Entry.Handle.IsValid())
+		{
+			Entry.Handle->ReleaseHandle();
+		}
+
+		if (Entry.bResident)
+		{
+			Stats.ResidentBytes -= Entry.Bytes;
+			--Stats.NumResident;
+		}
+	}
+}
+
+bool UEAEquipmentPreloadSubsystem::IsResident(const UEAEquipmentDefinition* ItemDef) const
+{
+	const FPreloadEntry* Entry = ItemDef ? Entries.Find(FSoftObjectPath(ItemDef)) : nullptr;
+	return Entry && Entry->bResident;
+}
+
+void UEAEquipmentPreloadSubsystem::NotifyEquipped(const UEAEquipmentDefinition* ItemDef)
+{
+	if (!ItemDef)
+	{
+		return;
+	}
+
+	if (FPreloadEntry* Entry = Entries.Find(FSoftObjectPath(ItemDef)))
+	{
+		Entry->LastUsed = ++UseCounter;
+		if (Entry->bResident)
+		{
+			++Stats.Hits;
+			return;
+		}
+	}
+
+	++Stats.Misses;
+}
+
+void UEAEquipmentPreloadSubsystem::ResetStats()
+{
+	Stats.Hits = 0;
+	Stats.Misses = 0;
+	Stats.Evictions = 0;
+}
+
+int64 UEAEquipmentPreloadSubsystem::EstimateBytes(const FStreamableHandle& Handle)
+{
+	TArray<UObject*> LoadedAssets;
+	Handle.GetLoadedAssets(LoadedAssets);
+
+	int64 TotalBytes = 0;
+	for (UObject* Asset : LoadedAssets)
+	{
+		if (Asset)
+		{
+			TotalBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+	return TotalBytes;
+}
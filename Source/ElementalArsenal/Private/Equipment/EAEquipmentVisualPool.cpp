@@ -0,0 +1,191 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Equipment/EAEquipmentVisualPool.h"
+#include "EAReactionSettings.h"
+#include "EADiagnostics.h"
+#include "Animation/SkeletalMeshActor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Acquire Pooled Visual"), STAT_EA_AcquirePooledVisual, STATGROUP_ElementalArsenal);
+
+namespace EAEquipmentVisualPool
+{
+	static void ConfigureMeshComponent(UPrimitiveComponent* MeshComponent)
+	{
+		MeshComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+		MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		MeshComponent->SetGenerateOverlapEvents(false);
+	}
+
+	static UPrimitiveComponent* GetMeshComponent(AActor* Actor)
+	{
+		if (ASkeletalMeshActor* SkeletalActor = Cast<ASkeletalMeshActor>(Actor))
+		{
+			return SkeletalActor->GetSkeletalMeshComponent();
+		}
+		if (AStaticMeshActor* StaticActor = Cast<AStaticMeshActor>(Actor))
+		{
+			return StaticActor->GetStaticMeshComponent();
+		}
+		return nullptr;
+	}
+}
+
+bool UEAEquipmentVisualPool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEAEquipmentVisualPool::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
+	Prewarm(Settings->PrewarmSkeletalEquipmentActors, Settings->PrewarmStaticEquipmentActors);
+}
+
+void UEAEquipmentVisualPool::Deinitialize()
+{
+	// The world tears down its actors itself
+	FreeSkeletalActors.Empty();
+	FreeStaticActors.Empty();
+
+	Super::Deinitialize();
+}
+
+template<typename ActorType>
+ActorType* UEAEquipmentVisualPool::SpawnPooledActor()
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+
+	ActorType* NewActor = GetWorld()->SpawnActor<ActorType>(ActorType::StaticClass(), FTransform::Identity, SpawnParams);
+	if (NewActor)
+	{
+		// Equipment visuals only follow their socket. Movable so the mesh can be swapped on reuse.
+		UPrimitiveComponent* MeshComponent = EAEquipmentVisualPool::GetMeshComponent(NewActor);
+		MeshComponent->SetMobility(EComponentMobility::Movable);
+		EAEquipmentVisualPool::ConfigureMeshComponent(MeshComponent);
+		NewActor->SetActorEnableCollision(false);
+		NewActor->SetActorTickEnabled(false);
+
+		// Every machine builds its own visuals from the replicated slot state
+		NewActor->SetReplicates(false);
+		++Stats.Spawned;
+	}
+	return NewActor;
+}
+
+template<typename ActorType>
+ActorType* UEAEquipmentVisualPool::AcquireFromPool(TArray<TObjectPtr<ActorType>>& FreeActors, AActor* Owner)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_AcquirePooledVisual);
+
+	ActorType* Actor = nullptr;
+	while (!Actor && FreeActors.Num() > 0)
+	{
+		// Skip anything that got destroyed behind our back (e.g. level streaming)
+		ActorType* Candidate = FreeActors.Pop(false);
+		if (IsValid(Candidate))
+		{
+			Actor = Candidate;
+			++Stats.Reused;
+		}
+	}
+
+	if (!Actor)
+	{
+		Actor = SpawnPooledActor<ActorType>();
+	}
+
+	if (Actor)
+	{
+		Actor->SetOwner(Owner);
+		Actor->SetActorHiddenInGame(false);
+	}
+	return Actor;
+}
+
+ASkeletalMeshActor* UEAEquipmentVisualPool::AcquireSkeletalMeshActor(AActor* Owner)
+{
+	return AcquireFromPool(FreeSkeletalActors, Owner);
+}
+
+AStaticMeshActor* UEAEquipmentVisualPool::AcquireStaticMeshActor(AActor* Owner)
+{
+	return AcquireFromPool(FreeStaticActors, Owner);
+}
+
+void UEAEquipmentVisualPool::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetOwner(nullptr);
+
+	const int32 MaxPooled = GetDefault<UEAReactionSettings>()->MaxPooledEquipmentActors;
+
+	// Drop the mesh reference so pooled actors do not keep evicted assets alive
+	if (ASkeletalMeshActor* SkeletalActor = Cast<ASkeletalMeshActor>(Actor))
+	{
+		if (FreeSkeletalActors.Num() < MaxPooled)
+		{
+			SkeletalActor->GetSkeletalMeshComponent()->SetSkeletalMesh(nullptr);
+			FreeSkeletalActors.Add(SkeletalActor);
+			return;
+		}
+	}
+	else if (AStaticMeshActor* StaticActor = Cast<AStaticMeshActor>(Actor))
+	{
+		if (FreeStaticActors.Num() < MaxPooled)
+		{
+			StaticActor->GetStaticMeshComponent()->SetStaticMesh(nullptr);
+			FreeStaticActors.Add(StaticActor);
+			return;
+		}
+	}
+
+	Actor->Destroy();
+	++Stats.Destroyed;
+}
+
+void UEAEquipmentVisualPool::Prewarm(int32 NumSkeletal, int32 NumStatic)
+{
+	while (FreeSkeletalActors.Num() < NumSkeletal)
+	{
+		ASkeletalMeshActor* NewActor = SpawnPooledActor<ASkeletalMeshActor>();
+		if (!NewActor)
+		{
+			break;
+		}
+		NewActor->SetActorHiddenInGame(true);
+		FreeSkeletalActors.Add(NewActor);
+	}
+
+	while (FreeStaticActors.Num() < NumStatic)
+	{
+		AStaticMeshActor* NewActor = SpawnPooledActor<AStaticMeshActor>();
+		if (!NewActor)
+		{
+			break;
+		}
+		NewActor->SetActorHiddenInGame(true);
+		FreeStaticActors.Add(NewActor);
+	}
+}
+
+FEAEquipmentVisualPoolStats UEAEquipmentVisualPool::GetStats() const
+{
+	FEAEquipmentVisualPoolStats Result = Stats;
+	Result.FreeSkeletal = FreeSkeletalActors.Num();
+	Result.FreeStatic = FreeStaticActors.Num();
+	return Result;
+}
@@ -2,98 +2,482 @@
 
 #include "Gas/EAAttributeSet.h"
 #include "ElementalArsenal.h"
+#include "EADiagnostics.h"
+#include "EACombatEvents.h"
+#include "EACombatLog.h"
 #include "GameplayEffectExtension.h"
 #include "GameplayEffect.h"
-#include "GameplayTagsManager.h"
+#include "Gas/EAReactionSubsystem.h"
+#include "Gas/EAReactionWorldSubsystem.h"
 #include "EAReactionSettings.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Misc/ScopeExit.h"
+
+DECLARE_CYCLE_STAT(TEXT("PostGameplayEffectExecute"), STAT_EA_PostGameplayEffectExecute, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Resolve Damage"), STAT_EA_ResolveDamage, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Flush Aggregated Damage"), STAT_EA_FlushAggregatedDamage, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Process Reaction"), STAT_EA_ProcessReaction, STATGROUP_ElementalArsenal);
+
+namespace EAAttributeSet
+{
+	// The attacker's copy of this set, if it has one (GetSet<> only hands out const pointers)
+	static UEAAttributeSet* FindElementalAttributeSet(const UAbilitySystemComponent& ASC)
+	{
+		for (UAttributeSet* Set : ASC.GetSpawnedAttributes())
+		{
+			if (UEAAttributeSet* ElementalSet = Cast<UEAAttributeSet>(Set))
+			{
+				return ElementalSet;
+			}
+		}
+		return nullptr;
+	}
+
+	// Damage multiplier for a resistance value. Resistance above 1 is treated as immunity.
+	static float GetDamageMultiplier(float Resistance)
+	{
+		return 1.f - FMath::Min(Resistance, 1.f);
+	}
+
+	// A hit being recorded to the combat log. Captured before any reaction changes the tags, written once resolved.
+	struct FRecordedDecision
+	{
+		FGameplayTagContainer SourceTags;
+		FGameplayTagContainer TargetTags;
+		TArray<const FElementalReactionRule*, TInlineAllocator<8>> Matches;
+		TArray<const FElementalReactionRule*, TInlineAllocator<8>> Applied;
+		bool bAppliedKnown = true;
+	};
+
+	// Matches the hit again with the tag containers, the way the replay commandlet will
+	static void CaptureReactionDecision(const FEAReactionIndex& Index, const UAbilitySystemComponent* SourceASC, const UAbilitySystemComponent& TargetASC, FRecordedDecision& OutDecision)
+	{
+		OutDecision.SourceTags = SourceASC ? SourceASC->GetOwnedGameplayTags() : FGameplayTagContainer::EmptyContainer;
+		OutDecision.TargetTags = TargetASC.GetOwnedGameplayTags();
+
+		FEAReactionIndex::FRuleIndexArray MatchedRules;
+		Index.FindMatchingRules(OutDecision.SourceTags, OutDecision.TargetTags, MatchedRules);
+
+		for (const int32 RuleIndex : MatchedRules)
+		{
+			OutDecision.Matches.Add(&Index.GetRule(RuleIndex));
+		}
+	}
+}
 
 UEAAttributeSet::UEAAttributeSet()
 	: bIsProcessingReaction(false)
+	, ReactiveSourceMask(0)
+	, ReactiveTargetMask(0)
+{
+}
+
+void UEAAttributeSet::BeginDestroy()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AggregationTimerHandle);
+	}
+	AggregatedDamage.Reset();
+
+	UnbindReactiveTagEvents();
+	UnbindExecuteEvents();
+	Super::BeginDestroy();
+}
+
+void UEAAttributeSet::GetReactiveTagMasks(const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe>& Index, uint64& OutSourceMask, uint64& OutTargetMask)
+{
+	UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (!ASC)
+	{
+		OutSourceMask = OutTargetMask = 0;
+		return;
+	}
+
+	// (Re)build on first use, after the index was rebuilt, or if we moved to another ASC
+	if (ReactiveMaskIndex.Get() != &Index.Get() || ReactiveMaskASC.Get() != ASC)
+	{
+		UnbindReactiveTagEvents();
+
+		ReactiveMaskIndex = Index;
+		ReactiveMaskASC = ASC;
+		ReactiveSourceMask = Index->ComputeSourceMask(*ASC);
+		ReactiveTargetMask = Index->ComputeTargetMask(*ASC);
+
+		if (Index->SupportsMasks())
+		{
+			ReactiveTagEventHandle = ASC->RegisterGenericGameplayTagEvent().AddUObject(this, &UEAAttributeSet::OnReactiveTagChanged);
+		}
+	}
+
+	OutSourceMask = ReactiveSourceMask;
+	OutTargetMask = ReactiveTargetMask;
+}
+
+void UEAAttributeSet::OnReactiveTagChanged(const FGameplayTag Tag, int32 NewCount)
 {
+	if (!ReactiveMaskIndex.IsValid())
+	{
+		return;
+	}
+
+	// Parent tags get their own event, so only the exact rule tags need to be checked
+	if (const uint64 SourceBit = ReactiveMaskIndex->GetSourceTagBit(Tag))
+	{
+		ReactiveSourceMask = NewCount > 0 ? (ReactiveSourceMask | SourceBit) : (ReactiveSourceMask & ~SourceBit);
+	}
+
+	if (const uint64 TargetBit = ReactiveMaskIndex->GetTargetTagBit(Tag))
+	{
+		ReactiveTargetMask = NewCount > 0 ? (ReactiveTargetMask | TargetBit) : (ReactiveTargetMask & ~TargetBit);
+	}
+}
+
+void UEAAttributeSet::UnbindReactiveTagEvents()
+{
+	if (UAbilitySystemComponent* ASC = ReactiveMaskASC.Get())
+	{
+		ASC->RegisterGenericGameplayTagEvent().Remove(ReactiveTagEventHandle);
+	}
+
+	ReactiveTagEventHandle.Reset();
+	ReactiveMaskASC.Reset();
+	ReactiveMaskIndex.Reset();
+}
+
+bool UEAAttributeSet::TryBeginSpecReaction(const FGameplayEffectSpec& Spec)
+{
+	UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (!ASC)
+	{
+		return true;
+	}
+
+	if (ExecuteEventsASC.Get() != ASC)
+	{
+		UnbindExecuteEvents();
+
+		ExecuteEventsASC = ASC;
+		AppliedEventHandle = ASC->OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UEAAttributeSet::OnSpecExecuted);
+		PeriodicEventHandle = ASC->OnPeriodicGameplayEffectExecuteDelegateOnSelf.AddUObject(this, &UEAAttributeSet::OnSpecExecuted);
+	}
+
+	// Executions are synchronous, so nothing in here can outlive the frame. Also drops entries an unusual execution
+	// path never reported as finished.
+	if (ReactedSpecsFrame != GFrameCounter)
+	{
+		ReactedSpecs.Reset();
+		ReactedSpecsFrame = GFrameCounter;
+	}
+
+	if (ReactedSpecs.Contains(&Spec))
+	{
+		return false;
+	}
+
+	ReactedSpecs.Add(&Spec);
+	return true;
+}
+
+void UEAAttributeSet::OnSpecExecuted(UAbilitySystemComponent* ASC, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	// The spec is still alive here; once it is freed, its address may belong to the next hit
+	ReactedSpecs.RemoveSingleSwap(&Spec, false);
+}
+
+void UEAAttributeSet::UnbindExecuteEvents()
+{
+	if (UAbilitySystemComponent* ASC = ExecuteEventsASC.Get())
+	{
+		ASC->OnGameplayEffectAppliedDelegateToSelf.Remove(AppliedEventHandle);
+		ASC->OnPeriodicGameplayEffectExecuteDelegateOnSelf.Remove(PeriodicEventHandle);
+	}
+
+	AppliedEventHandle.Reset();
+	PeriodicEventHandle.Reset();
+	ExecuteEventsASC.Reset();
+	ReactedSpecs.Reset();
 }
 
 void UEAAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_PostGameplayEffectExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 
-	if (Data.EvaluatedData.Attribute == GetIncomingDamageAttribute())
+	if (IsIncomingDamageAttribute(Data.EvaluatedData.Attribute))
 	{
-		const float LocalDamage = GetIncomingDamage();
-		SetIncomingDamage(0.f);
+		ResolveIncomingDamage(Data);
+	}
+}
 
-		if (LocalDamage > 0.f)
+bool UEAAttributeSet::IsIncomingDamageAttribute(const FGameplayAttribute& Attribute)
+{
+	return Attribute == GetIncomingDamageAttribute()
+		|| Attribute == GetIncomingFireDamageAttribute()
+		|| Attribute == GetIncomingIceDamageAttribute()
+		|| Attribute == GetIncomingLightningDamageAttribute();
+}
+
+void UEAAttributeSet::ResolveIncomingDamage(const FGameplayEffectModCallbackData& Data)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ResolveDamage);
+
+	// 1. Consume every damage meta attribute, whichever one this modifier targeted
+	const float UntypedDamage = FMath::Max(GetIncomingDamage(), 0.f);
+	const float FireDamage = FMath::Max(GetIncomingFireDamage(), 0.f);
+	const float IceDamage = FMath::Max(GetIncomingIceDamage(), 0.f);
+	const float LightningDamage = FMath::Max(GetIncomingLightningDamage(), 0.f);
+
+	SetIncomingDamage(0.f);
+	SetIncomingFireDamage(0.f);
+	SetIncomingIceDamage(0.f);
+	SetIncomingLightningDamage(0.f);
+
+	const float RawDamage = UntypedDamage + FireDamage + IceDamage + LightningDamage;
+	if (RawDamage <= 0.f)
+	{
+		return;
+	}
+
+	// 2. Mitigate and apply actual health damage
+	const float MitigatedDamage = UntypedDamage
+		+ FireDamage * EAAttributeSet::GetDamageMultiplier(GetFireResistance())
+		+ IceDamage * EAAttributeSet::GetDamageMultiplier(GetIceResistance())
+		+ LightningDamage * EAAttributeSet::GetDamageMultiplier(GetLightningResistance());
+
+	// The window publishes its hits once Health has changed, so HealthAfter is the post-damage value
+	if (GetDefault<UEAReactionSettings>()->bAggregateDamage && GetWorld())
+	{
+		AggregateDamage(Data, RawDamage, MitigatedDamage);
+		return;
+	}
+
+	ApplyMitigatedDamage(MitigatedDamage);
+
+	// 3. Publish the hit. Free while nobody listens.
+	if (FEACombatEventStream::IsActive())
+	{
+		const UAbilitySystemComponent* SourceASC = Data.EffectSpec.GetContext().GetOriginalInstigatorAbilitySystemComponent();
+		FEACombatEvent Event(EEACombatEventType::Damage, SourceASC ? SourceASC->GetAvatarActor() : nullptr, Data.Target.GetAvatarActor());
+		Event.EffectName = Data.EffectSpec.Def ? Data.EffectSpec.Def->GetClass()->GetFName() : NAME_None;
+		Event.RawDamage = RawDamage;
+		Event.Damage = MitigatedDamage;
+		Event.HealthAfter = GetHealth();
+		FEACombatEventStream::Publish(Event);
+	}
+
+	// 4. Try Elemental Reaction, once per effect. A hit reacts even when fully resisted.
+	if (TryBeginSpecReaction(Data.EffectSpec))
+	{
+		ProcessElementalReaction(Data.EffectSpec.GetContext().GetOriginalInstigatorAbilitySystemComponent(), Data.EffectSpec.Def ? Data.EffectSpec.Def->GetClass() : nullptr, MitigatedDamage);
+	}
+}
+
+void UEAAttributeSet::ApplyMitigatedDamage(float MitigatedDamage)
+{
+	if (MitigatedDamage != 0.f)
+	{
+		SetHealth(FMath::Clamp(GetHealth() - MitigatedDamage, 0.0f, GetMaxHealth()));
+	}
+}
+
+void UEAAttributeSet::AggregateDamage(const FGameplayEffectModCallbackData& Data, float RawDamage, float MitigatedDamage)
+{
+	UAbilitySystemComponent* SourceASC = Data.EffectSpec.GetContext().GetOriginalInstigatorAbilitySystemComponent();
+	const UClass* EffectClass = Data.EffectSpec.Def ? Data.EffectSpec.Def->GetClass() : nullptr;
+
+	// Resistances were applied per hit, so one running total per source and effect keeps the damage exact
+	FAggregatedDamage* Entry = AggregatedDamage.FindByPredicate([SourceASC, EffectClass](const FAggregatedDamage& Existing)
+	{
+		return Existing.SourceASC.Get() == SourceASC && Existing.EffectClass == EffectClass;
+	});
+
+	if (!Entry)
+	{
+		Entry = &AggregatedDamage.AddDefaulted_GetRef();
+		Entry->SourceASC = SourceASC;
+		Entry->SourceAvatar = SourceASC ? SourceASC->GetAvatarActor() : nullptr;
+		Entry->EffectClass = EffectClass;
+	}
+	Entry->RawDamage += RawDamage;
+	Entry->MitigatedDamage += MitigatedDamage;
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (!TimerManager.TimerExists(AggregationTimerHandle))
+	{
+		const float Window = GetDefault<UEAReactionSettings>()->DamageAggregationWindow;
+		if (Window > 0.f)
+		{
+			TimerManager.SetTimer(AggregationTimerHandle, this, &UEAAttributeSet::FlushAggregatedDamage, Window, false);
+		}
+		else
 		{
-			// Apply actual health damage
-			const float OldHealth = GetHealth();
-			SetHealth(FMath::Clamp(OldHealth - LocalDamage, 0.0f, GetMaxHealth()));
+			AggregationTimerHandle = TimerManager.SetTimerForNextTick(this, &UEAAttributeSet::FlushAggregatedDamage);
+		}
+	}
+}
 
-			// Try Elemental Reaction
-			ProcessElementalReaction(Data);
+void UEAAttributeSet::FlushAggregatedDamage()
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_FlushAggregatedDamage);
+
+	AggregationTimerHandle.Invalidate();
+
+	// Reactions can deal damage to us again, which starts the next window
+	TArray<FAggregatedDamage, TInlineAllocator<2>> Window = MoveTemp(AggregatedDamage);
+	AggregatedDamage.Reset();
+
+	float TotalDamage = 0.f;
+	for (const FAggregatedDamage& Entry : Window)
+	{
+		TotalDamage += Entry.MitigatedDamage;
+	}
+	ApplyMitigatedDamage(TotalDamage);
+
+	// One damage event per source and effect, now that Health reflects the whole window
+	if (FEACombatEventStream::IsActive())
+	{
+		const UAbilitySystemComponent* TargetASC = GetOwningAbilitySystemComponent();
+		const AActor* TargetAvatar = TargetASC ? TargetASC->GetAvatarActor() : nullptr;
+
+		for (const FAggregatedDamage& Entry : Window)
+		{
+			FEACombatEvent Event(EEACombatEventType::Damage, Entry.SourceAvatar.Get(), TargetAvatar);
+			Event.EffectName = Entry.EffectClass ? Entry.EffectClass->GetFName() : NAME_None;
+			Event.RawDamage = Entry.RawDamage;
+			Event.Damage = Entry.MitigatedDamage;
+			Event.HealthAfter = GetHealth();
+			FEACombatEventStream::Publish(Event);
+		}
+	}
+
+	for (const FAggregatedDamage& Entry : Window)
+	{
+		// Sources destroyed during the window still dealt their damage, but can no longer react
+		if (UAbilitySystemComponent* SourceASC = Entry.SourceASC.Get())
+		{
+			ProcessElementalReaction(SourceASC, Entry.EffectClass, Entry.MitigatedDamage);
 		}
 	}
 }
 
-void UEAAttributeSet::ProcessElementalReaction(const FGameplayEffectModCallbackData& Data)
+void UEAAttributeSet::ProcessElementalReaction(UAbilitySystemComponent* SourceASC, const UClass* SourceEffectClass, float Damage)
 {
 	// 0. Recursion Guard: Prevent re-entry on the same target
 	if (bIsProcessingReaction)
 	{
+		INC_DWORD_STAT(STAT_EA_ReactionsSuppressed);
 		return;
 	}
 
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ProcessReaction);
+
 	// Use TGuardValue to ensure the flag is reset when we leave this function scope
 	TGuardValue<bool> ScopedRecursionGuard(bIsProcessingReaction, true);
 
-	// 1. Get Context
-	FGameplayEffectContextHandle Context = Data.EffectSpec.GetContext();
-	UAbilitySystemComponent* SourceASC = Context.GetOriginalInstigatorAbilitySystemComponent();
-	UAbilitySystemComponent* TargetASC = &Data.Target;
+	const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+	if (!ReactionSubsystem) return;
+
+	const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> ReactionIndex = ReactionSubsystem->GetReactionIndex();
+
+	// Recording takes its own slow path, so the fast paths below stay untouched
+	TOptional<EAAttributeSet::FRecordedDecision> RecordedDecision;
+	if (FEACombatRecorder::IsRecording() && GetOwningAbilitySystemComponent())
+	{
+		EAAttributeSet::CaptureReactionDecision(*ReactionIndex, SourceASC, *GetOwningAbilitySystemComponent(), RecordedDecision.Emplace());
+	}
+
+	// Written on every exit, so hits rejected early are recorded with no reactions applied
+	ON_SCOPE_EXIT
+	{
+		if (RecordedDecision.IsSet())
+		{
+			FEACombatRecorder::RecordDecision(RecordedDecision->SourceTags, RecordedDecision->TargetTags, SourceEffectClass, Damage,
+				RecordedDecision->Matches, RecordedDecision->Applied, RecordedDecision->bAppliedKnown);
+		}
+	};
+
+	if (ReactionIndex->IsEmpty()) return;
+
+	// 1. Fast path: a target without any reactive status cannot react, whoever hit it
+	uint64 UnusedMask = 0;
+	uint64 TargetMask = 0;
+	GetReactiveTagMasks(ReactionIndex, UnusedMask, TargetMask);
+
+	if (ReactionIndex->SupportsMasks() && TargetMask == 0) return;
+
+	// 2. Get Context
+	UAbilitySystemComponent* TargetASC = GetOwningAbilitySystemComponent();
 
 	if (!SourceASC || !TargetASC) return;
 
-	// 2. Get Tags
-	FGameplayTagContainer SourceTags;
-	SourceASC->GetOwnedGameplayTags(SourceTags); 
+	// 3. Pre-filter on the source mask. Use the tracked mask when the attacker also carries this set.
+	uint64 SourceMask = 0;
+	if (UEAAttributeSet* SourceSet = EAAttributeSet::FindElementalAttributeSet(*SourceASC))
+	{
+		SourceSet->GetReactiveTagMasks(ReactionIndex, SourceMask, UnusedMask);
+	}
+	else
+	{
+		SourceMask = ReactionIndex->ComputeSourceMask(*SourceASC);
+	}
+
+	if (!ReactionIndex->CanReact(SourceMask, TargetMask)) return;
+
+	UEAReactionWorldSubsystem* ReactionWorld = UWorld::GetSubsystem<UEAReactionWorldSubsystem>(TargetASC->GetWorld());
+
+	// Inside an FEAScopedReactionBatch the rule lookup is done for the whole batch at once
+	if (ReactionWorld && ReactionWorld->IsBatchingReactions())
+	{
+		FEAReactionMatchRequest Request;
+		Request.SourceASC = SourceASC;
+		Request.TargetASC = TargetASC;
+		Request.SourceEffectClass = SourceEffectClass;
+		ReactionWorld->AddBatchedReaction(Request);
+
+		if (RecordedDecision.IsSet())
+		{
+			RecordedDecision->bAppliedKnown = false;
+		}
+		return;
+	}
 
-	FGameplayTagContainer TargetTags;
-	TargetASC->GetOwnedGameplayTags(TargetTags);
+	// 4. Get Tags (by reference, no per-hit container copies)
+	const FGameplayTagContainer& SourceTags = SourceASC->GetOwnedGameplayTags();
 
-	// 3. Iterate over Rules from Project Settings
-	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
-	if (!Settings) return;
+	// 5. Look up candidate rules in the compiled index
+	FEAReactionIndex::FRuleIndexArray MatchedRules;
+	ReactionIndex->FindMatchingRules(SourceTags, *TargetASC, MatchedRules);
+	INC_DWORD_STAT_BY(STAT_EA_ReactionsMatched, MatchedRules.Num());
 
-	for (const FElementalReactionRule& Rule : Settings->ReactionRules)
+	for (const int32 RuleIndex : MatchedRules)
 	{
+		const FElementalReactionRule& Rule = ReactionIndex->GetRule(RuleIndex);
+
 		// Recursion Guard: If the effect that just applied damage IS this rule's reaction effect, skip.
-		if (Data.EffectSpec.Def && Data.EffectSpec.Def->GetClass() == Rule.ReactionEffect)
+		if (SourceEffectClass && SourceEffectClass == Rule.ReactionEffect)
 		{
+			INC_DWORD_STAT(STAT_EA_ReactionsSuppressed);
 			continue;
 		}
 
-		// Check if we match the Source and Target tags
-		if (Rule.SourceTag.IsValid() && Rule.TargetTag.IsValid() && Rule.ReactionEffect)
+		// MATCH FOUND! Applied now, or queued for the end-of-frame batch
+		bool bSubmitted = true;
+		if (ReactionWorld)
 		{
-			if (SourceTags.HasTag(Rule.SourceTag) && TargetTags.HasTag(Rule.TargetTag))
-			{
-				// MATCH FOUND!
-				UE_LOG(LogElementalArsenal, Log, TEXT("Elemental Reaction Triggered: %s on %s -> Applying %s"), 
-					*Rule.SourceTag.ToString(), 
-					*Rule.TargetTag.ToString(), 
-					*Rule.ReactionEffect->GetName());
-
-				// Apply the configured Gameplay Effect
-				FGameplayEffectContextHandle EffectContext = SourceASC->MakeEffectContext();
-				EffectContext.AddSourceObject(SourceASC->GetAvatarActor());
-
-				FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(Rule.ReactionEffect, 1.0f, EffectContext);
-				if (SpecHandle.IsValid())
-				{
-					// Mark this as a reaction to prevent infinite loops
-					SpecHandle.Data->AddDynamicAssetTag(FGameplayTag::RequestGameplayTag(FName("Effect.Reaction")));
-					
-					SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
-				}
-			}
+			bSubmitted = ReactionWorld->SubmitReaction(*SourceASC, *TargetASC, *ReactionIndex, RuleIndex);
+		}
+		else
+		{
+			UEAReactionWorldSubsystem::ApplyReactionEffect(*SourceASC, *TargetASC, Rule);
+			UEAReactionWorldSubsystem::PublishReactionEvent(*SourceASC, *TargetASC, *ReactionIndex, RuleIndex);
+		}
+
+		if (bSubmitted && RecordedDecision.IsSet())
+		{
+			RecordedDecision->Applied.Add(&Rule);
 		}
 	}
 }
@@ -0,0 +1,515 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Gas/EAReactionIndex.h"
+#include "Gas/EAReactionRuleSet.h"
+#include "GameplayTagsManager.h"
+#include "AbilitySystemComponent.h"
+#include "Algo/Sort.h"
+#include "ElementalArsenal.h"
+#include "EADiagnostics.h"
+#include <atomic>
+
+DECLARE_CYCLE_STAT(TEXT("Find Matching Rules"), STAT_EA_FindMatchingRules, STATGROUP_ElementalArsenal);
+
+int32 FEAReactionIndex::FindOrAddSourceBucket(const FGameplayTag& SourceTag, const FBuildInput& Input, TMap<FGameplayTag, int32>& BucketIndexBySourceTag)
+{
+	if (const int32* ExistingIndex = BucketIndexBySourceTag.Find(SourceTag))
+	{
+		return *ExistingIndex;
+	}
+
+	const int32 BucketIndex = SourceBuckets.AddDefaulted();
+	SourceBuckets[BucketIndex].SourceTag = SourceTag;
+	BucketIndexBySourceTag.Add(SourceTag, BucketIndex);
+
+	// Map the tag and all of its children to the new bucket
+	SourceBucketsByTag.FindOrAdd(SourceTag).Add(BucketIndex);
+	if (const FGameplayTagContainer* ChildTags = Input.SourceTagChildren.Find(SourceTag))
+	{
+		for (const FGameplayTag& ChildTag : *ChildTags)
+		{
+			SourceBucketsByTag.FindOrAdd(ChildTag).Add(BucketIndex);
+		}
+	}
+	return BucketIndex;
+}
+
+FEAReactionIndex::FTargetBucket& FEAReactionIndex::FindOrAddTargetBucket(FSourceBucket& Bucket, const FGameplayTag& TargetTag)
+{
+	FTargetBucket* Target = Bucket.Targets.FindByPredicate([&TargetTag](const FTargetBucket& Entry)
+	{
+		return Entry.TargetTag == TargetTag;
+	});
+
+	if (!Target)
+	{
+		Target = &Bucket.Targets.AddDefaulted_GetRef();
+		Target->TargetTag = TargetTag;
+	}
+	return *Target;
+}
+
+bool FEAReactionIndex::AddRuleToTarget(FTargetBucket& Target, int32 RuleIndex) const
+{
+	// The same reaction defined twice (e.g. by two rule sets) would otherwise apply twice per hit
+	const FElementalReactionRule& Rule = Rules[RuleIndex];
+	if (Target.RuleIndices.ContainsByPredicate([this, &Rule](int32 ExistingIndex) { return Rules[ExistingIndex].IsDuplicateOf(Rule); }))
+	{
+		return false;
+	}
+
+	Target.RuleIndices.Add(RuleIndex);
+	return true;
+}
+
+FEAReactionIndex::FBuildInput FEAReactionIndex::GatherBuildInput(const TArray<FElementalReactionRule>& InRules, TConstArrayView<const UEAReactionRuleSet*> RuleSets)
+{
+	check(IsInGameThread());
+
+	FBuildInput Input;
+
+	int32 NumRules = InRules.Num();
+	for (const UEAReactionRuleSet* RuleSet : RuleSets)
+	{
+		NumRules += RuleSet->Rules.Num();
+	}
+
+	Input.Rules.Reserve(NumRules);
+	Input.Rules.Append(InRules);
+	Input.NumProjectRules = InRules.Num();
+
+	Input.RuleSets.Reserve(RuleSets.Num());
+	for (const UEAReactionRuleSet* RuleSet : RuleSets)
+	{
+		FBuildInput::FRuleSetRange& Range = Input.RuleSets.AddDefaulted_GetRef();
+		Range.RuleOffset = Input.Rules.Num();
+		Range.NumRules = RuleSet->Rules.Num();
+		Range.CompiledBuckets = RuleSet->GetCompiledBuckets();
+		Input.Rules.Append(RuleSet->Rules);
+	}
+
+	// The tag tree can change at runtime (e.g. a plugin registering tags), so expand it here rather than on the worker
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	for (const FElementalReactionRule& Rule : Input.Rules)
+	{
+		if (Rule.SourceTag.IsValid() && !Input.SourceTagChildren.Contains(Rule.SourceTag))
+		{
+			Input.SourceTagChildren.Add(Rule.SourceTag, TagsManager.RequestGameplayTagChildren(Rule.SourceTag));
+		}
+	}
+
+	return Input;
+}
+
+TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> FEAReactionIndex::Build(const FBuildInput& Input)
+{
+	static std::atomic<uint32> NextGeneration(1);
+
+	TSharedRef<FEAReactionIndex, ESPMode::ThreadSafe> Index = MakeShared<FEAReactionIndex, ESPMode::ThreadSafe>();
+	Index->Generation = NextGeneration++;
+	Index->Rules = Input.Rules;
+
+	TMap<FGameplayTag, int32> BucketIndexBySourceTag;
+	int32 NumDuplicates = 0;
+
+	// 1. Group the project settings rules by SourceTag, then by TargetTag
+	for (int32 RuleIndex = 0; RuleIndex < Input.NumProjectRules; ++RuleIndex)
+	{
+		const FElementalReactionRule& Rule = Input.Rules[RuleIndex];
+		if (!Rule.IsValid())
+		{
+			continue;
+		}
+
+		const int32 BucketIndex = Index->FindOrAddSourceBucket(Rule.SourceTag, Input, BucketIndexBySourceTag);
+		FTargetBucket& Target = FindOrAddTargetBucket(Index->SourceBuckets[BucketIndex], Rule.TargetTag);
+		NumDuplicates += Index->AddRuleToTarget(Target, RuleIndex) ? 0 : 1;
+	}
+
+	// 2. Rule sets come grouped already, so merging costs one lookup per group instead of per rule
+	for (const FBuildInput::FRuleSetRange& RuleSet : Input.RuleSets)
+	{
+		const int32 RuleOffset = RuleSet.RuleOffset;
+
+		if (RuleSet.CompiledBuckets.Num() > 0)
+		{
+			for (const FEAReactionRuleBucket& Compiled : RuleSet.CompiledBuckets)
+			{
+				const int32 BucketIndex = Index->FindOrAddSourceBucket(Compiled.SourceTag, Input, BucketIndexBySourceTag);
+				FTargetBucket& Target = FindOrAddTargetBucket(Index->SourceBuckets[BucketIndex], Compiled.TargetTag);
+
+				for (const int32 LocalIndex : Compiled.RuleIndices)
+				{
+					// The effect class can still fail to load
+					if (Index->Rules[RuleOffset + LocalIndex].IsValid())
+					{
+						NumDuplicates += Index->AddRuleToTarget(Target, RuleOffset + LocalIndex) ? 0 : 1;
+					}
+				}
+			}
+			continue;
+		}
+
+		for (int32 LocalIndex = 0; LocalIndex < RuleSet.NumRules; ++LocalIndex)
+		{
+			const FElementalReactionRule& Rule = Input.Rules[RuleOffset + LocalIndex];
+			if (!Rule.IsValid())
+			{
+				continue;
+			}
+
+			const int32 BucketIndex = Index->FindOrAddSourceBucket(Rule.SourceTag, Input, BucketIndexBySourceTag);
+			FTargetBucket& Target = FindOrAddTargetBucket(Index->SourceBuckets[BucketIndex], Rule.TargetTag);
+			NumDuplicates += Index->AddRuleToTarget(Target, RuleOffset + LocalIndex) ? 0 : 1;
+		}
+	}
+
+	if (NumDuplicates > 0)
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("Reaction index: ignored %d duplicate rule(s) (same tags, conditions and effect as an earlier rule)."), NumDuplicates);
+	}
+
+	// 3. Compile conditions, priorities and exclusivity groups
+	Index->CompileConditions();
+
+	// 4. Assign mask bits. Source bits follow bucket order.
+	Index->bSupportsMasks = Index->SourceBuckets.Num() <= 64;
+	Index->CompatibleTargetMasks.SetNumZeroed(Index->SourceBuckets.Num());
+
+	for (int32 BucketIndex = 0; BucketIndex < Index->SourceBuckets.Num() && Index->bSupportsMasks; ++BucketIndex)
+	{
+		const FSourceBucket& Bucket = Index->SourceBuckets[BucketIndex];
+		Index->SourceTagBits.Add(Bucket.SourceTag, 1ull << BucketIndex);
+
+		for (const FTargetBucket& Target : Bucket.Targets)
+		{
+			uint64* TargetBit = Index->TargetTagBits.Find(Target.TargetTag);
+			if (!TargetBit)
+			{
+				if (Index->TargetTagBits.Num() >= 64)
+				{
+					Index->bSupportsMasks = false;
+					break;
+				}
+				TargetBit = &Index->TargetTagBits.Add(Target.TargetTag, 1ull << Index->TargetTagBits.Num());
+			}
+
+			Index->CompatibleTargetMasks[BucketIndex] |= *TargetBit;
+		}
+	}
+
+	if (!Index->bSupportsMasks)
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("Reaction index: more than 64 distinct source or target tags, bitmask pre-filter disabled."));
+		Index->SourceTagBits.Reset();
+		Index->TargetTagBits.Reset();
+		Index->CompatibleTargetMasks.Reset();
+	}
+
+	return Index;
+}
+
+void FEAReactionIndex::CompileConditions()
+{
+	TMap<FGameplayTag, int32> SourceBitByTag;
+	TMap<FGameplayTag, int32> TargetBitByTag;
+	TMap<FName, int32> GroupIndexByName;
+
+	auto CompileCondition = [this](const FEAReactionTagCondition& Condition, TArray<FGameplayTag>& ConditionTags, TMap<FGameplayTag, int32>& BitByTag, FCompiledCondition& OutCompiled)
+	{
+		auto TagsToBits = [this, &ConditionTags, &BitByTag](const FGameplayTagContainer& Tags)
+		{
+			uint64 Bits = 0;
+			for (const FGameplayTag& Tag : Tags)
+			{
+				int32* Bit = BitByTag.Find(Tag);
+				if (!Bit)
+				{
+					Bit = &BitByTag.Add(Tag, ConditionTags.Add(Tag));
+				}
+
+				if (*Bit < 64)
+				{
+					Bits |= 1ull << *Bit;
+				}
+				else
+				{
+					bCompiledConditions = false;
+				}
+			}
+			return Bits;
+		};
+
+		OutCompiled.RequireAll = TagsToBits(Condition.RequireAll);
+		OutCompiled.RequireAny = TagsToBits(Condition.RequireAny);
+		OutCompiled.RequireNone = TagsToBits(Condition.RequireNone);
+	};
+
+	CompiledRules.SetNum(Rules.Num());
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FElementalReactionRule& Rule = Rules[RuleIndex];
+		FCompiledRule& Compiled = CompiledRules[RuleIndex];
+
+		CompileCondition(Rule.SourceConditions, SourceConditionTags, SourceBitByTag, Compiled.Source);
+		CompileCondition(Rule.TargetConditions, TargetConditionTags, TargetBitByTag, Compiled.Target);
+		Compiled.Priority = Rule.Priority;
+
+		if (!Rule.ExclusivityGroup.IsNone())
+		{
+			int32* GroupIndex = GroupIndexByName.Find(Rule.ExclusivityGroup);
+			Compiled.ExclusivityGroup = GroupIndex ? *GroupIndex : GroupIndexByName.Add(Rule.ExclusivityGroup, NumExclusivityGroups++);
+		}
+
+		bNeedsResolve |= Compiled.Priority != 0 || Compiled.ExclusivityGroup != INDEX_NONE || !Rule.SourceConditions.IsEmpty() || !Rule.TargetConditions.IsEmpty();
+	}
+
+	if (!bCompiledConditions)
+	{
+		UE_LOG(LogElementalArsenal, Warning, TEXT("Reaction index: more than 64 distinct condition tags on one side, conditions are evaluated without bitmasks."));
+	}
+}
+
+template<typename PredicateType>
+uint64 FEAReactionIndex::ComputeConditionBits(TConstArrayView<FGameplayTag> ConditionTags, PredicateType&& HasTag)
+{
+	uint64 Bits = 0;
+	for (int32 Bit = 0; Bit < ConditionTags.Num(); ++Bit)
+	{
+		if (HasTag(ConditionTags[Bit]))
+		{
+			Bits |= 1ull << Bit;
+		}
+	}
+	return Bits;
+}
+
+template<typename PredicateType>
+bool FEAReactionIndex::PassesCondition(const FEAReactionTagCondition& Condition, PredicateType&& HasTag)
+{
+	for (const FGameplayTag& Tag : Condition.RequireAll)
+	{
+		if (!HasTag(Tag))
+		{
+			return false;
+		}
+	}
+	for (const FGameplayTag& Tag : Condition.RequireNone)
+	{
+		if (HasTag(Tag))
+		{
+			return false;
+		}
+	}
+	if (Condition.RequireAny.IsEmpty())
+	{
+		return true;
+	}
+	for (const FGameplayTag& Tag : Condition.RequireAny)
+	{
+		if (HasTag(Tag))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FEAReactionIndex::CanRuleReactWith(int32 RuleIndex, const UAbilitySystemComponent& TargetASC) const
+{
+	const FElementalReactionRule& Rule = Rules[RuleIndex];
+	auto HasTargetTag = [&TargetASC](const FGameplayTag& Tag) { return TargetASC.HasMatchingGameplayTag(Tag); };
+
+	return Rule.IsValid() && HasTargetTag(Rule.TargetTag) && PassesCondition(Rule.TargetConditions, HasTargetTag);
+}
+
+uint64 FEAReactionIndex::ComputeSourceMask(const UAbilitySystemComponent& ASC) const
+{
+	uint64 Mask = 0;
+	for (const TPair<FGameplayTag, uint64>& Entry : SourceTagBits)
+	{
+		if (ASC.HasMatchingGameplayTag(Entry.Key))
+		{
+			Mask |= Entry.Value;
+		}
+	}
+	return Mask;
+}
+
+uint64 FEAReactionIndex::ComputeTargetMask(const UAbilitySystemComponent& ASC) const
+{
+	uint64 Mask = 0;
+	for (const TPair<FGameplayTag, uint64>& Entry : TargetTagBits)
+	{
+		if (ASC.HasMatchingGameplayTag(Entry.Key))
+		{
+			Mask |= Entry.Value;
+		}
+	}
+	return Mask;
+}
+
+bool FEAReactionIndex::CanReact(uint64 SourceMask, uint64 TargetMask) const
+{
+	if (!bSupportsMasks)
+	{
+		return !IsEmpty();
+	}
+
+	if (SourceMask == 0 || TargetMask == 0)
+	{
+		return false;
+	}
+
+	uint64 ReachableTargets = 0;
+	for (uint64 Remaining = SourceMask; Remaining != 0; Remaining &= Remaining - 1)
+	{
+		ReachableTargets |= CompatibleTargetMasks[FMath::CountTrailingZeros64(Remaining)];
+	}
+
+	return (ReachableTargets & TargetMask) != 0;
+}
+
+template<typename TargetPredicateType>
+void FEAReactionIndex::FindMatchingRulesInternal(const FGameplayTagContainer& SourceTags, TargetPredicateType&& HasTargetTag, FRuleIndexArray& OutRuleIndices) const
+{
+	if (SourceBuckets.Num() == 0)
+	{
+		return;
+	}
+
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_FindMatchingRules);
+
+	// A parent and its child may both be owned, so make sure each bucket is only visited once
+	TBitArray<TInlineAllocator<2>> VisitedBuckets(false, SourceBuckets.Num());
+	const int32 FirstNewIndex = OutRuleIndices.Num();
+
+	for (const FGameplayTag& OwnedTag : SourceTags)
+	{
+		const TArray<int32, TInlineAllocator<1>>* BucketIndices = SourceBucketsByTag.Find(OwnedTag);
+		if (!BucketIndices)
+		{
+			continue;
+		}
+
+		for (const int32 BucketIndex : *BucketIndices)
+		{
+			if (VisitedBuckets[BucketIndex])
+			{
+				continue;
+			}
+			VisitedBuckets[BucketIndex] = true;
+
+			for (const FTargetBucket& Target : SourceBuckets[BucketIndex].Targets)
+			{
+				INC_DWORD_STAT_BY(STAT_EA_RulesEvaluated, Target.RuleIndices.Num());
+				if (HasTargetTag(Target.TargetTag))
+				{
+					OutRuleIndices.Append(Target.RuleIndices);
+				}
+			}
+		}
+	}
+
+	if (OutRuleIndices.Num() == FirstNewIndex)
+	{
+		return;
+	}
+
+	if (!bNeedsResolve)
+	{
+		// Keep the configured rule order so reactions apply in the same order as before
+		Algo::Sort(MakeArrayView(OutRuleIndices.GetData() + FirstNewIndex, OutRuleIndices.Num() - FirstNewIndex));
+		return;
+	}
+
+	// 1. Drop candidates whose conditions fail. Each condition tag is queried at most once per hit.
+	auto HasSourceTag = [&SourceTags](const FGameplayTag& Tag) { return SourceTags.HasTag(Tag); };
+	TOptional<uint64> SourceBits;
+	TOptional<uint64> TargetBits;
+	int32 NumKept = FirstNewIndex;
+
+	for (int32 Position = FirstNewIndex; Position < OutRuleIndices.Num(); ++Position)
+	{
+		const int32 RuleIndex = OutRuleIndices[Position];
+		const FCompiledRule& Compiled = CompiledRules[RuleIndex];
+		bool bPasses = true;
+
+		if (!bCompiledConditions)
+		{
+			bPasses = PassesCondition(Rules[RuleIndex].SourceConditions, HasSourceTag) && PassesCondition(Rules[RuleIndex].TargetConditions, HasTargetTag);
+		}
+		else
+		{
+			if (!Compiled.Source.IsEmpty())
+			{
+				if (!SourceBits.IsSet())
+				{
+					SourceBits = ComputeConditionBits(SourceConditionTags, HasSourceTag);
+				}
+				bPasses = Compiled.Source.Passes(SourceBits.GetValue());
+			}
+			if (bPasses && !Compiled.Target.IsEmpty())
+			{
+				if (!TargetBits.IsSet())
+				{
+					TargetBits = ComputeConditionBits(TargetConditionTags, HasTargetTag);
+				}
+				bPasses = Compiled.Target.Passes(TargetBits.GetValue());
+			}
+		}
+
+		if (bPasses)
+		{
+			OutRuleIndices[NumKept++] = RuleIndex;
+		}
+	}
+	OutRuleIndices.SetNum(NumKept, false);
+
+	// 2. Highest priority first, then rule order
+	Algo::Sort(MakeArrayView(OutRuleIndices.GetData() + FirstNewIndex, OutRuleIndices.Num() - FirstNewIndex), [this](int32 A, int32 B)
+	{
+		const int32 PriorityA = CompiledRules[A].Priority;
+		const int32 PriorityB = CompiledRules[B].Priority;
+		return PriorityA != PriorityB ? PriorityA > PriorityB : A < B;
+	});
+
+	// 3. The first rule of each exclusivity group is its winner
+	if (NumExclusivityGroups > 0)
+	{
+		TBitArray<TInlineAllocator<2>> ClaimedGroups(false, NumExclusivityGroups);
+		NumKept = FirstNewIndex;
+
+		for (int32 Position = FirstNewIndex; Position < OutRuleIndices.Num(); ++Position)
+		{
+			const int32 RuleIndex = OutRuleIndices[Position];
+			const int32 Group = CompiledRules[RuleIndex].ExclusivityGroup;
+			if (Group != INDEX_NONE)
+			{
+				if (ClaimedGroups[Group])
+				{
+					continue;
+				}
+				ClaimedGroups[Group] = true;
+			}
+			OutRuleIndices[NumKept++] = RuleIndex;
+		}
+		OutRuleIndices.SetNum(NumKept, false);
+	}
+}
+
+void FEAReactionIndex::FindMatchingRules(const FGameplayTagContainer& SourceTags, const FGameplayTagContainer& TargetTags, FRuleIndexArray& OutRuleIndices) const
+{
+	if (TargetTags.IsEmpty())
+	{
+		return;
+	}
+
+	FindMatchingRulesInternal(SourceTags, [&TargetTags](const FGameplayTag& Tag) { return TargetTags.HasTag(Tag); }, OutRuleIndices);
+}
+
+void FEAReactionIndex::FindMatchingRules(const FGameplayTagContainer& SourceTags, const UAbilitySystemComponent& TargetASC, FRuleIndexArray& OutRuleIndices) const
+{
+	// HasMatchingGameplayTag is a hashed lookup into the ASC's count map, which already includes parent tags
+	FindMatchingRulesInternal(SourceTags, [&TargetASC](const FGameplayTag& Tag) { return TargetASC.HasMatchingGameplayTag(Tag); }, OutRuleIndices);
+}
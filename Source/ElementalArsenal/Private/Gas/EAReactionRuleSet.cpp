@@ -0,0 +1,195 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Gas/EAReactionRuleSet.h"
+#include "EAReactionSettings.h"
+#include "ElementalArsenal.h"
+#include "Misc/Crc.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "EAReactionRuleSet"
+
+TConstArrayView<FEAReactionRuleBucket> UEAReactionRuleSet::GetCompiledBuckets() const
+{
+	// Cooked sets were compiled by PreSave and cannot change afterwards. Only the editor edits rules in place
+	// (details panel, undo, scripts), so only the editor pays for hashing the tag names.
+#if WITH_EDITOR
+	if (CompiledBucketKey != ComputeBucketKey())
+	{
+		return TConstArrayView<FEAReactionRuleBucket>();
+	}
+#endif
+	return CompiledBuckets;
+}
+
+void UEAReactionRuleSet::CompileBuckets()
+{
+	CompiledBuckets.Reset();
+
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FElementalReactionRule& Rule = Rules[RuleIndex];
+		if (!Rule.IsValid())
+		{
+			continue;
+		}
+
+		FEAReactionRuleBucket* Bucket = CompiledBuckets.FindByPredicate([&Rule](const FEAReactionRuleBucket& Entry)
+		{
+			return Entry.SourceTag == Rule.SourceTag && Entry.TargetTag == Rule.TargetTag;
+		});
+
+		if (!Bucket)
+		{
+			Bucket = &CompiledBuckets.AddDefaulted_GetRef();
+			Bucket->SourceTag = Rule.SourceTag;
+			Bucket->TargetTag = Rule.TargetTag;
+		}
+
+		Bucket->RuleIndices.Add(RuleIndex);
+	}
+
+	CompiledBucketKey = ComputeBucketKey();
+}
+
+uint32 UEAReactionRuleSet::ComputeBucketKey() const
+{
+	// Tag names rather than FName hashes, which differ between sessions while the key is saved with the asset
+	uint32 Key = GetTypeHash(Rules.Num());
+	for (const FElementalReactionRule& Rule : Rules)
+	{
+		Key = FCrc::StrCrc32(*Rule.SourceTag.ToString(), Key);
+		Key = FCrc::StrCrc32(*Rule.TargetTag.ToString(), Key);
+		Key = HashCombine(Key, Rule.IsValid() ? 1u : 0u);
+	}
+	return Key;
+}
+
+#if WITH_EDITOR
+void UEAReactionRuleSet::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	CompileBuckets();
+
+	// Cook time: errors here fail the cook, so broken rule sets never ship
+	if (SaveContext.IsCooking())
+	{
+		TArray<FText> Errors;
+		TArray<FText> Warnings;
+		ValidateRules(Rules, Errors, Warnings);
+
+		for (const FText& Error : Errors)
+		{
+			UE_LOG(LogElementalArsenal, Error, TEXT("%s: %s"), *GetPathName(), *Error.ToString());
+		}
+		for (const FText& Warning : Warnings)
+		{
+			UE_LOG(LogElementalArsenal, Warning, TEXT("%s: %s"), *GetPathName(), *Warning.ToString());
+		}
+	}
+}
+
+void UEAReactionRuleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Before Super, which notifies UEAReactionSubsystem and makes it rebuild the index from the buckets
+	CompileBuckets();
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+EDataValidationResult UEAReactionRuleSet::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	TArray<FText> Errors;
+	TArray<FText> Warnings;
+	ValidateRules(Rules, Errors, Warnings);
+
+	// Rules also present in the project settings would apply twice
+	const TArray<FElementalReactionRule>& ProjectRules = GetDefault<UEAReactionSettings>()->ReactionRules;
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FElementalReactionRule& Rule = Rules[RuleIndex];
+		const bool bInProjectSettings = ProjectRules.ContainsByPredicate([&Rule](const FElementalReactionRule& Other)
+		{
+			return Other.IsDuplicateOf(Rule);
+		});
+
+		if (bInProjectSettings)
+		{
+			Warnings.Add(FText::Format(LOCTEXT("DuplicateOfProjectRule", "Rule {0} is also defined in Project Settings -> Elemental Arsenal and will only be applied once."), RuleIndex));
+		}
+	}
+
+	for (const FText& Error : Errors)
+	{
+		Context.AddError(Error);
+	}
+	for (const FText& Warning : Warnings)
+	{
+		Context.AddWarning(Warning);
+	}
+
+	if (Errors.Num() > 0)
+	{
+		Result = EDataValidationResult::Invalid;
+	}
+	else if (Result == EDataValidationResult::NotValidated)
+	{
+		Result = EDataValidationResult::Valid;
+	}
+	return Result;
+}
+
+void UEAReactionRuleSet::ValidateRules(TConstArrayView<FElementalReactionRule> InRules, TArray<FText>& OutErrors, TArray<FText>& OutWarnings)
+{
+	// Tag pair -> rules using it so far
+	TMap<TPair<FGameplayTag, FGameplayTag>, TArray<int32, TInlineAllocator<2>>> RulesByPair;
+
+	for (int32 RuleIndex = 0; RuleIndex < InRules.Num(); ++RuleIndex)
+	{
+		const FElementalReactionRule& Rule = InRules[RuleIndex];
+		if (!Rule.IsValid())
+		{
+			OutErrors.Add(FText::Format(LOCTEXT("InvalidRule", "Rule {0} is missing its Source Tag, Target Tag or Reaction Effect."), RuleIndex));
+			continue;
+		}
+
+		TArray<int32, TInlineAllocator<2>>& PairRules = RulesByPair.FindOrAdd(TPair<FGameplayTag, FGameplayTag>(Rule.SourceTag, Rule.TargetTag));
+		for (const int32 OtherIndex : PairRules)
+		{
+			const FElementalReactionRule& Other = InRules[OtherIndex];
+			if (Other.IsDuplicateOf(Rule))
+			{
+				OutErrors.Add(FText::Format(LOCTEXT("DuplicateRule", "Rule {0} duplicates rule {1} ({2} + {3} -> {4})."),
+					RuleIndex, OtherIndex, FText::FromName(Rule.SourceTag.GetTagName()), FText::FromName(Rule.TargetTag.GetTagName()), FText::FromString(GetNameSafe(Rule.ReactionEffect))));
+				continue;
+			}
+
+			// Different conditions are usually meant to be disjoint, so only identical triggers are reported
+			if (Other.SourceConditions != Rule.SourceConditions || Other.TargetConditions != Rule.TargetConditions)
+			{
+				continue;
+			}
+
+			if (Rule.ExclusivityGroup.IsNone() || Other.ExclusivityGroup != Rule.ExclusivityGroup)
+			{
+				OutWarnings.Add(FText::Format(LOCTEXT("ConflictingRule", "Rules {1} and {0} both react to {2} + {3}; both effects will be applied. Give them the same Exclusivity Group if only one should fire."),
+					RuleIndex, OtherIndex, FText::FromName(Rule.SourceTag.GetTagName()), FText::FromName(Rule.TargetTag.GetTagName())));
+			}
+			else if (Other.Priority == Rule.Priority)
+			{
+				OutWarnings.Add(FText::Format(LOCTEXT("TiedRule", "Rules {1} and {0} compete in group {2} with the same priority; rule {1} always wins."),
+					RuleIndex, OtherIndex, FText::FromName(Rule.ExclusivityGroup)));
+			}
+		}
+		PairRules.Add(RuleIndex);
+	}
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
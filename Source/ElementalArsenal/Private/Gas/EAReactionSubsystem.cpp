@@ -0,0 +1,267 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Gas/EAReactionSubsystem.h"
+#include "Gas/EAReactionRuleSet.h"
+#include "EAReactionSettings.h"
+#include "ElementalArsenal.h"
+#include "Engine/Engine.h"
+#include "GameplayTagsManager.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ConfigContext.h"
+#include "Misc/Paths.h"
+
+#if !UE_BUILD_SHIPPING
+namespace EAReactionSubsystem
+{
+	static bool bWatchConfig = true;
+	static FAutoConsoleVariableRef CVarWatchConfig(
+		TEXT("ea.Reactions.WatchConfig"),
+		bWatchConfig,
+		TEXT("Reload the reaction rules when DefaultGame.ini changes on disk. Not available in Shipping."));
+
+	static constexpr float ConfigPollInterval = 2.f;
+
+	static FString GetWatchedConfigPath()
+	{
+		return FPaths::ProjectConfigDir() / TEXT("DefaultGame.ini");
+	}
+
+	static void ReloadCommand()
+	{
+		if (UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get())
+		{
+			ReactionSubsystem->ReloadReactionRules();
+		}
+	}
+
+	static FAutoConsoleCommand ReloadRulesCommand(
+		TEXT("ea.Reactions.Reload"),
+		TEXT("Re-reads the reaction rules from the Game config and rebuilds the reaction index in the background."),
+		FConsoleCommandDelegate::CreateStatic(&ReloadCommand));
+}
+#endif
+
+void UEAReactionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LoadDefaultRuleSets();
+	RebuildReactionIndex();
+
+#if WITH_EDITOR
+	SettingsChangedHandle = GetMutableDefault<UEAReactionSettings>()->OnSettingChanged().AddUObject(this, &UEAReactionSubsystem::HandleSettingsChanged);
+	TagTreeChangedHandle = UGameplayTagsManager::OnEditorRefreshGameplayTagTree.AddUObject(this, &UEAReactionSubsystem::HandleTagTreeChanged);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UEAReactionSubsystem::HandleObjectPropertyChanged);
+#endif
+
+#if !UE_BUILD_SHIPPING
+	ConfigTimestamp = IFileManager::Get().GetTimeStamp(*EAReactionSubsystem::GetWatchedConfigPath());
+	ConfigPollHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UEAReactionSubsystem::PollConfigFile), EAReactionSubsystem::ConfigPollInterval);
+#endif
+}
+
+void UEAReactionSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	GetMutableDefault<UEAReactionSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+	UGameplayTagsManager::OnEditorRefreshGameplayTagTree.Remove(TagTreeChangedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif
+
+#if !UE_BUILD_SHIPPING
+	FTSTicker::GetCoreTicker().RemoveTicker(ConfigPollHandle);
+#endif
+
+	// Let a running build finish; its result is discarded by the serial bump
+	PendingBuild.Wait();
+	++BuildSerial;
+
+	DefaultRuleSets.Empty();
+	RegisteredRuleSets.Empty();
+	ReactionIndex.Reset();
+	Super::Deinitialize();
+}
+
+UEAReactionSubsystem* UEAReactionSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UEAReactionSubsystem>() : nullptr;
+}
+
+void UEAReactionSubsystem::RebuildReactionIndex()
+{
+	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
+
+	// Each set once, however often it is registered
+	TArray<const UEAReactionRuleSet*> RuleSets;
+	for (const TObjectPtr<const UEAReactionRuleSet>& RuleSet : DefaultRuleSets)
+	{
+		RuleSets.AddUnique(RuleSet);
+	}
+	for (const TObjectPtr<const UEAReactionRuleSet>& RuleSet : RegisteredRuleSets)
+	{
+		RuleSets.AddUnique(RuleSet);
+	}
+
+	++BuildSerial;
+	ReactionIndex = FEAReactionIndex::Build(Settings->ReactionRules, RuleSets);
+
+	UE_LOG(LogElementalArsenal, Log, TEXT("Reaction index rebuilt: %d rules (%d rule sets)"), ReactionIndex->NumRules(), RuleSets.Num());
+}
+
+void UEAReactionSubsystem::ReloadReactionRules()
+{
+	check(IsInGameThread());
+
+	// GConfig caches the ini files, so pull the Game hierarchy from disk before the settings re-read it
+	FConfigContext::ForceReloadIntoGConfig().Load(TEXT("Game"));
+	GetMutableDefault<UEAReactionSettings>()->ReloadConfig();
+
+	LoadDefaultRuleSets();
+	RebuildReactionIndexAsync();
+}
+
+void UEAReactionSubsystem::RebuildReactionIndexAsync()
+{
+	// 1. Snapshot the inputs on the game thread: the rule set UObjects and the tag tree are only read here
+	TArray<const UEAReactionRuleSet*> RuleSets;
+	for (const TObjectPtr<const UEAReactionRuleSet>& RuleSet : DefaultRuleSets)
+	{
+		RuleSets.AddUnique(RuleSet);
+	}
+	for (const TObjectPtr<const UEAReactionRuleSet>& RuleSet : RegisteredRuleSets)
+	{
+		RuleSets.AddUnique(RuleSet);
+	}
+
+	FEAReactionIndex::FBuildInput Input = FEAReactionIndex::GatherBuildInput(GetDefault<UEAReactionSettings>()->ReactionRules, RuleSets);
+
+	const uint32 Serial = ++BuildSerial;
+	TWeakObjectPtr<UEAReactionSubsystem> WeakThis(this);
+
+	// 2. Compile on a worker. Chained behind the previous build so only the latest one has to be tracked.
+	auto BuildTask = [WeakThis, Serial, Input = MoveTemp(Input), NumRuleSets = RuleSets.Num()]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> NewIndex = FEAReactionIndex::Build(Input);
+		const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		// 3. Swap on the game thread, where every reader takes its reference
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, NewIndex, BuildMs, NumRuleSets]()
+		{
+			UEAReactionSubsystem* ReactionSubsystem = WeakThis.Get();
+			if (!ReactionSubsystem)
+			{
+				return;
+			}
+
+			if (Serial != ReactionSubsystem->BuildSerial)
+			{
+				UE_LOG(LogElementalArsenal, Verbose, TEXT("Discarding reaction index build %u, a newer rebuild started."), Serial);
+				return;
+			}
+
+			ReactionSubsystem->ReactionIndex = NewIndex;
+			UE_LOG(LogElementalArsenal, Log, TEXT("Reaction index reloaded: %d rules (%d rule sets), built in %.2f ms"), NewIndex->NumRules(), NumRuleSets, BuildMs);
+		});
+	};
+
+	PendingBuild = PendingBuild.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(BuildTask), UE::Tasks::Prerequisites(PendingBuild))
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(BuildTask));
+}
+
+#if !UE_BUILD_SHIPPING
+bool UEAReactionSubsystem::PollConfigFile(float DeltaTime)
+{
+	if (!EAReactionSubsystem::bWatchConfig)
+	{
+		return true;
+	}
+
+	const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*EAReactionSubsystem::GetWatchedConfigPath());
+	if (Timestamp != ConfigTimestamp)
+	{
+		ConfigTimestamp = Timestamp;
+		UE_LOG(LogElementalArsenal, Log, TEXT("DefaultGame.ini changed, reloading reaction rules."));
+		ReloadReactionRules();
+	}
+	return true;
+}
+#endif
+
+void UEAReactionSubsystem::RegisterRuleSet(const UEAReactionRuleSet* RuleSet)
+{
+	if (!RuleSet)
+	{
+		return;
+	}
+
+	const bool bAlreadyInIndex = RegisteredRuleSets.Contains(RuleSet) || DefaultRuleSets.Contains(RuleSet);
+	RegisteredRuleSets.Add(RuleSet);
+
+	if (!bAlreadyInIndex)
+	{
+		RebuildReactionIndex();
+	}
+}
+
+void UEAReactionSubsystem::UnregisterRuleSet(const UEAReactionRuleSet* RuleSet)
+{
+	if (!RuleSet || RegisteredRuleSets.RemoveSingle(RuleSet) == 0)
+	{
+		return;
+	}
+
+	if (!RegisteredRuleSets.Contains(RuleSet) && !DefaultRuleSets.Contains(RuleSet))
+	{
+		RebuildReactionIndex();
+	}
+}
+
+void UEAReactionSubsystem::LoadDefaultRuleSets()
+{
+	DefaultRuleSets.Reset();
+
+	for (const TSoftObjectPtr<UEAReactionRuleSet>& RuleSetPath : GetDefault<UEAReactionSettings>()->DefaultRuleSets)
+	{
+		if (RuleSetPath.IsNull())
+		{
+			continue;
+		}
+
+		if (const UEAReactionRuleSet* RuleSet = RuleSetPath.LoadSynchronous())
+		{
+			DefaultRuleSets.Add(RuleSet);
+		}
+		else
+		{
+			UE_LOG(LogElementalArsenal, Error, TEXT("Could not load reaction rule set %s"), *RuleSetPath.ToString());
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UEAReactionSubsystem::HandleSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	LoadDefaultRuleSets();
+	RebuildReactionIndex();
+}
+
+void UEAReactionSubsystem::HandleTagTreeChanged()
+{
+	// Child tag expansion depends on the tag tree
+	RebuildReactionIndex();
+}
+
+void UEAReactionSubsystem::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// A rule set in use was edited
+	const UEAReactionRuleSet* RuleSet = Cast<UEAReactionRuleSet>(Object);
+	if (RuleSet && (DefaultRuleSets.Contains(RuleSet) || RegisteredRuleSets.Contains(RuleSet)))
+	{
+		RebuildReactionIndex();
+	}
+}
+#endif
@@ -0,0 +1,926 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Gas/EAReactionWorldSubsystem.h"
+#include "Gas/EAReactionSubsystem.h"
+#include "EAReactionSettings.h"
+#include "EAGameplayTags.h"
+#include "EADiagnostics.h"
+#include "EACombatEvents.h"
+#include "ElementalArsenal.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flush Deferred Reactions"), STAT_EA_FlushDeferredReactions, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Match Reaction Batch"), STAT_EA_MatchReactions, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Process Reaction Batch"), STAT_EA_ProcessReactionBatch, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Apply Reaction"), STAT_EA_ApplyReaction, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Process Reaction Propagation"), STAT_EA_ProcessPropagation, STATGROUP_ElementalArsenal);
+DECLARE_CYCLE_STAT(TEXT("Query Propagation Targets"), STAT_EA_QueryPropagationTargets, STATGROUP_ElementalArsenal);
+
+namespace EAReactionWorld
+{
+	static int32 ParallelBatchThreshold = 64;
+	static FAutoConsoleVariableRef CVarParallelBatchThreshold(
+		TEXT("ea.Reactions.ParallelBatchThreshold"),
+		ParallelBatchThreshold,
+		TEXT("Minimum number of source/target pairs before reaction matching runs with ParallelFor."));
+
+	static void LogReactionTriggered(const FElementalReactionRule& Rule)
+	{
+		UE_LOG(LogElementalArsenal, Verbose, TEXT("Elemental Reaction Triggered: %s on %s -> Applying %s"), 
+			*Rule.SourceTag.ToString(), 
+			*Rule.TargetTag.ToString(), 
+			*Rule.ReactionEffect->GetName());
+
+		EA_DEBUG_OVERLAY(FColor::Orange, TEXT("Reaction: %s + %s -> %s"),
+			*Rule.SourceTag.ToString(),
+			*Rule.TargetTag.ToString(),
+			*Rule.ReactionEffect->GetName());
+	}
+}
+
+FEAScopedReactionBatch::FEAScopedReactionBatch(const UWorld* World)
+	: ReactionWorld(UWorld::GetSubsystem<UEAReactionWorldSubsystem>(World))
+{
+	if (ReactionWorld)
+	{
+		++ReactionWorld->BatchScopeDepth;
+	}
+}
+
+FEAScopedReactionBatch::~FEAScopedReactionBatch()
+{
+	if (ReactionWorld && --ReactionWorld->BatchScopeDepth == 0)
+	{
+		TArray<FEAReactionMatchRequest> Requests = MoveTemp(ReactionWorld->BatchedRequests);
+		ReactionWorld->ProcessReactionBatch(Requests);
+	}
+}
+
+void FEAReactionQueueTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Owner)
+	{
+		Owner->FlushDeferredReactions();
+		Owner->ProcessPropagationQueue();
+	}
+}
+
+FString FEAReactionQueueTickFunction::DiagnosticMessage()
+{
+	return TEXT("FEAReactionQueueTickFunction");
+}
+
+bool UEAReactionWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEAReactionWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
+
+	// Only enabled while something is queued
+	QueueTickFunction.Owner = this;
+	QueueTickFunction.bCanEverTick = true;
+	QueueTickFunction.bStartWithTickEnabled = false;
+	QueueTickFunction.bTickEvenWhenPaused = false;
+	QueueTickFunction.TickGroup = Settings->ReactionFlushTickGroup;
+	QueueTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UEAReactionWorldSubsystem::Deinitialize()
+{
+	if (QueueTickFunction.IsTickFunctionRegistered())
+	{
+		QueueTickFunction.UnRegisterTickFunction();
+	}
+
+	PendingReactions.Empty();
+	PendingReactionKeys.Empty();
+	ResetPropagation();
+	ResetSpecCache();
+	ReactionTimes.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEAReactionWorldSubsystem::SubmitReaction(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex)
+{
+	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
+	if (!Settings->bDeferReactions || !QueueTickFunction.IsTickFunctionRegistered())
+	{
+		return ApplyReaction(SourceASC, TargetASC, Index, RuleIndex);
+	}
+
+	// Rule indices from an older index are meaningless, drop them
+	if (PendingIndexGeneration != Index.GetGeneration())
+	{
+		PendingReactions.Reset();
+		PendingReactionKeys.Reset();
+		PendingIndexGeneration = Index.GetGeneration();
+	}
+
+	bool bAlreadyQueued = false;
+	PendingReactionKeys.Add(FPendingReactionKey(FObjectKey(&TargetASC), RuleIndex), &bAlreadyQueued);
+	if (bAlreadyQueued)
+	{
+		return true;
+	}
+
+	FPendingReaction& Pending = PendingReactions.AddDefaulted_GetRef();
+	Pending.SourceASC = &SourceASC;
+	Pending.TargetASC = &TargetASC;
+	Pending.RuleIndex = RuleIndex;
+
+	QueueTickFunction.SetTickFunctionEnable(true);
+	return true;
+}
+
+void UEAReactionWorldSubsystem::FlushDeferredReactions()
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_FlushDeferredReactions);
+
+	const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+	if (!ReactionSubsystem || PendingReactions.Num() == 0)
+	{
+		PendingReactions.Reset();
+		PendingReactionKeys.Reset();
+		UpdateQueueTickEnabled();
+		return;
+	}
+
+	const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> ReactionIndex = ReactionSubsystem->GetReactionIndex();
+	if (PendingIndexGeneration != ReactionIndex->GetGeneration())
+	{
+		PendingReactions.Reset();
+		PendingReactionKeys.Reset();
+		UpdateQueueTickEnabled();
+		return;
+	}
+
+	const int32 MaxPerFlush = GetDefault<UEAReactionSettings>()->MaxDeferredReactionsPerFlush;
+	const int32 NumToResolve = MaxPerFlush > 0 ? FMath::Min(MaxPerFlush, PendingReactions.Num()) : PendingReactions.Num();
+
+	// Move the batch out first: applying effects can queue new reactions, which belong to the next frame
+	TArray<FPendingReaction> Batch;
+	Batch.Append(PendingReactions.GetData(), NumToResolve);
+	PendingReactions.RemoveAt(0, NumToResolve, false);
+
+	// Reactions hitting many targets trigger follow-up reactions on each of them; match those as one batch
+	int32 NumResolved = 0;
+	{
+		FEAScopedReactionBatch ReactionBatch(GetWorld());
+		for (; NumResolved < Batch.Num() && HasReactionBudget(); ++NumResolved)
+		{
+			const FPendingReaction& Pending = Batch[NumResolved];
+			PendingReactionKeys.Remove(FPendingReactionKey(FObjectKey(Pending.TargetASC.Get()), Pending.RuleIndex));
+
+			UAbilitySystemComponent* SourceASC = Pending.SourceASC.Get();
+			UAbilitySystemComponent* TargetASC = Pending.TargetASC.Get();
+			if (SourceASC && TargetASC)
+			{
+				ApplyReaction(*SourceASC, *TargetASC, *ReactionIndex, Pending.RuleIndex);
+			}
+		}
+	}
+
+	// Out of frame budget: put the rest back at the front, their keys are still registered
+	if (NumResolved < Batch.Num())
+	{
+		PendingReactions.Insert(Batch.GetData() + NumResolved, Batch.Num() - NumResolved, 0);
+	}
+
+	UpdateQueueTickEnabled();
+}
+
+void UEAReactionWorldSubsystem::UpdateQueueTickEnabled()
+{
+	if (QueueTickFunction.IsTickFunctionRegistered())
+	{
+		QueueTickFunction.SetTickFunctionEnable(PendingReactions.Num() > 0 || GetNumQueuedPropagations() > 0);
+	}
+}
+
+void UEAReactionWorldSubsystem::MatchReactions(TConstArrayView<FEAReactionMatchRequest> Requests, const FEAReactionIndex& Index, TArray<FEAReactionMatch>& OutMatches)
+{
+	check(IsInGameThread());
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_MatchReactions);
+
+	// Each request writes only its own slot, so workers never share output
+	TArray<FEAReactionIndex::FRuleIndexArray> PerRequestRules;
+	PerRequestRules.SetNum(Requests.Num());
+
+	ParallelFor(Requests.Num(), [&Requests, &Index, &PerRequestRules](int32 RequestIndex)
+	{
+		const FEAReactionMatchRequest& Request = Requests[RequestIndex];
+		if (Request.SourceASC && Request.TargetASC)
+		{
+			Index.FindMatchingRules(Request.SourceASC->GetOwnedGameplayTags(), *Request.TargetASC, PerRequestRules[RequestIndex]);
+		}
+	}, Requests.Num() < EAReactionWorld::ParallelBatchThreshold);
+
+	for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+	{
+		const UClass* SourceEffectClass = Requests[RequestIndex].SourceEffectClass;
+		INC_DWORD_STAT_BY(STAT_EA_ReactionsMatched, PerRequestRules[RequestIndex].Num());
+
+		for (const int32 RuleIndex : PerRequestRules[RequestIndex])
+		{
+			// Recursion Guard: same as the single-hit path
+			if (SourceEffectClass && SourceEffectClass == Index.GetRule(RuleIndex).ReactionEffect)
+			{
+				INC_DWORD_STAT(STAT_EA_ReactionsSuppressed);
+				continue;
+			}
+
+			OutMatches.Add({ RequestIndex, RuleIndex });
+		}
+	}
+}
+
+void UEAReactionWorldSubsystem::ProcessReactionBatch(TConstArrayView<FEAReactionMatchRequest> Requests)
+{
+	const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+	if (!ReactionSubsystem || Requests.Num() == 0)
+	{
+		return;
+	}
+
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ProcessReactionBatch);
+
+	const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> ReactionIndex = ReactionSubsystem->GetReactionIndex();
+
+	TArray<FEAReactionMatch> Matches;
+	MatchReactions(Requests, *ReactionIndex, Matches);
+
+	for (const FEAReactionMatch& Match : Matches)
+	{
+		const FEAReactionMatchRequest& Request = Requests[Match.RequestIndex];
+		SubmitReaction(*Request.SourceASC, *Request.TargetASC, *ReactionIndex, Match.RuleIndex);
+	}
+}
+
+bool UEAReactionWorldSubsystem::ApplyReaction(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex)
+{
+	if (!TryApplyReaction(SourceASC, TargetASC, Index, RuleIndex))
+	{
+		return false;
+	}
+
+	if (Index.GetRule(RuleIndex).PropagationRadius > 0.f)
+	{
+		StartPropagationChain(SourceASC, TargetASC, Index, RuleIndex);
+	}
+	return true;
+}
+
+bool UEAReactionWorldSubsystem::TryApplyReaction(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ApplyReaction);
+
+	if (!HasReactionBudget() || !TryConsumeReactionLimits(TargetASC, Index, RuleIndex))
+	{
+		INC_DWORD_STAT(STAT_EA_ReactionsSuppressed);
+		return false;
+	}
+
+	const FElementalReactionRule& Rule = Index.GetRule(RuleIndex);
+
+	EAReactionWorld::LogReactionTriggered(Rule);
+
+	// Copy the handle: applying the effect can change the source's tags and invalidate the cache entry
+	const bool bCacheSpecs = GetDefault<UEAReactionSettings>()->bCacheReactionSpecs;
+	const FGameplayEffectSpecHandle SpecHandle = bCacheSpecs
+		? GetOrMakeReactionSpec(SourceASC, Index, RuleIndex, 1.0f)
+		: MakeReactionSpec(SourceASC, Rule, 1.0f);
+
+	if (SpecHandle.IsValid())
+	{
+		if (bCacheSpecs)
+		{
+			// A cached spec is shared by every target this frame. Each application gets its own context,
+			// so hit results or actors added while one target executes do not carry over to the next.
+			FGameplayEffectSpec Spec(*SpecHandle.Data.Get());
+			Spec.SetContext(Spec.GetContext().Duplicate());
+			SourceASC.ApplyGameplayEffectSpecToTarget(Spec, &TargetASC);
+		}
+		else
+		{
+			SourceASC.ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), &TargetASC);
+		}
+		INC_DWORD_STAT(STAT_EA_ReactionsApplied);
+		++NumReactionsApplied;
+
+		PublishReactionEvent(SourceASC, TargetASC, Index, RuleIndex);
+	}
+	return true;
+}
+
+void UEAReactionWorldSubsystem::StartPropagationChain(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& OriginASC, const FEAReactionIndex& Index, int32 RuleIndex)
+{
+	// Nothing would ever advance the chain
+	if (!QueueTickFunction.IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	// Rule indices from an older index are meaningless, drop the chains still running
+	if (PropagationIndexGeneration != Index.GetGeneration())
+	{
+		ResetPropagation();
+		PropagationIndexGeneration = Index.GetGeneration();
+	}
+
+	const uint32 ChainId = NextPropagationChainId++;
+	PropagationChains.Add(ChainId).Visited.Add(FObjectKey(&OriginASC));
+
+	ExpandPropagation(SourceASC, OriginASC, Index, RuleIndex, ChainId, 1);
+
+	if (PropagationChains.FindChecked(ChainId).NumQueued == 0)
+	{
+		PropagationChains.Remove(ChainId);
+		return;
+	}
+
+	UpdateQueueTickEnabled();
+}
+
+void UEAReactionWorldSubsystem::ExpandPropagation(UAbilitySystemComponent& SourceASC, const UAbilitySystemComponent& OriginASC, const FEAReactionIndex& Index, int32 RuleIndex, uint32 ChainId, int32 Depth)
+{
+	const AActor* OriginActor = OriginASC.GetAvatarActor();
+	FPropagationChain* Chain = PropagationChains.Find(ChainId);
+	if (!OriginActor || !Chain)
+	{
+		return;
+	}
+
+	const float Radius = Index.GetRule(RuleIndex).PropagationRadius;
+	const FVector Origin = OriginActor->GetActorLocation();
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& CandidatePtr : QueryPropagationCandidates(Origin, Radius))
+	{
+		UAbilitySystemComponent* Candidate = CandidatePtr.Get();
+		const AActor* CandidateActor = Candidate ? Candidate->GetAvatarActor() : nullptr;
+		if (!CandidateActor || FVector::DistSquared(CandidateActor->GetActorLocation(), Origin) > FMath::Square(Radius))
+		{
+			continue;
+		}
+
+		// Unreactive targets are not marked visited, a later hop may find them tagged
+		if (Chain->Visited.Contains(FObjectKey(Candidate)) || !Index.CanRuleReactWith(RuleIndex, *Candidate))
+		{
+			continue;
+		}
+
+		Chain->Visited.Add(FObjectKey(Candidate));
+		++Chain->NumQueued;
+
+		FPropagationNode& Node = PropagationQueue.AddDefaulted_GetRef();
+		Node.SourceASC = &SourceASC;
+		Node.TargetASC = Candidate;
+		Node.RuleIndex = RuleIndex;
+		Node.Depth = Depth;
+		Node.ChainId = ChainId;
+	}
+}
+
+void UEAReactionWorldSubsystem::ProcessPropagationQueue()
+{
+	if (GetNumQueuedPropagations() == 0)
+	{
+		return;
+	}
+
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ProcessPropagation);
+
+	const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+	if (!ReactionSubsystem || PropagationIndexGeneration != ReactionSubsystem->GetReactionIndex()->GetGeneration())
+	{
+		ResetPropagation();
+		UpdateQueueTickEnabled();
+		return;
+	}
+
+	const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> ReactionIndex = ReactionSubsystem->GetReactionIndex();
+	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
+	const double Deadline = FPlatformTime::Seconds() + Settings->PropagationBudgetMs / 1000.0;
+
+	// Always make progress on at least one hop, however small the budget
+	int32 NumProcessed = 0;
+	{
+		// A spreading reaction is an AoE: the follow-up reactions it triggers on each target are matched as one batch
+		FEAScopedReactionBatch ReactionBatch(GetWorld());
+		while (PropagationQueueHead < PropagationQueue.Num() && HasReactionBudget())
+		{
+			if (NumProcessed > 0
+				&& ((Settings->MaxPropagationsPerFrame > 0 && NumProcessed >= Settings->MaxPropagationsPerFrame)
+					|| (Settings->PropagationBudgetMs > 0.f && FPlatformTime::Seconds() >= Deadline)))
+			{
+				break;
+			}
+
+			// Copy: applying the effect can start new chains and grow the queue
+			const FPropagationNode Node = PropagationQueue[PropagationQueueHead++];
+			++NumProcessed;
+
+			UAbilitySystemComponent* SourceASC = Node.SourceASC.Get();
+			UAbilitySystemComponent* TargetASC = Node.TargetASC.Get();
+
+			// Tags may have changed while the hop was queued
+			if (SourceASC && TargetASC && ReactionIndex->CanRuleReactWith(Node.RuleIndex, *TargetASC)
+				&& TryApplyReaction(*SourceASC, *TargetASC, *ReactionIndex, Node.RuleIndex))
+			{
+				INC_DWORD_STAT(STAT_EA_ReactionsPropagated);
+
+				if (Node.Depth < ReactionIndex->GetRule(Node.RuleIndex).MaxPropagationDepth)
+				{
+					ExpandPropagation(*SourceASC, *TargetASC, *ReactionIndex, Node.RuleIndex, Node.ChainId, Node.Depth + 1);
+				}
+			}
+
+			// Looked up again, the reaction above may have added chains
+			FPropagationChain* Chain = PropagationChains.Find(Node.ChainId);
+			if (Chain && --Chain->NumQueued == 0)
+			{
+				PropagationChains.Remove(Node.ChainId);
+			}
+		}
+	}
+
+	if (PropagationQueueHead == PropagationQueue.Num())
+	{
+		PropagationQueue.Reset();
+		PropagationQueueHead = 0;
+	}
+	else if (PropagationQueueHead * 2 > PropagationQueue.Num())
+	{
+		PropagationQueue.RemoveAt(0, PropagationQueueHead, false);
+		PropagationQueueHead = 0;
+	}
+
+	UpdateQueueTickEnabled();
+}
+
+const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& UEAReactionWorldSubsystem::QueryPropagationCandidates(const FVector& Origin, float Radius)
+{
+	// Actors move between frames
+	if (PropagationQueryCacheFrame != GFrameCounter)
+	{
+		PropagationQueryCache.Reset();
+		PropagationQueryCacheFrame = GFrameCounter;
+	}
+
+	const UEAReactionSettings* Settings = GetDefault<UEAReactionSettings>();
+	const float CellSize = FMath::Max(Settings->PropagationQueryCellSize, 10.f);
+	const FIntVector Cell(FMath::FloorToInt(Origin.X / CellSize), FMath::FloorToInt(Origin.Y / CellSize), FMath::FloorToInt(Origin.Z / CellSize));
+
+	const FPropagationQueryKey Key(Cell, FMath::CeilToInt(Radius));
+	if (const TArray<TWeakObjectPtr<UAbilitySystemComponent>>* Cached = PropagationQueryCache.Find(Key))
+	{
+		return *Cached;
+	}
+
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_QueryPropagationTargets);
+
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>>& Candidates = PropagationQueryCache.Add(Key);
+
+	// Sphere around the cell center reaching Radius past every point in the cell
+	const FVector CellCenter = (FVector(Cell) + FVector(0.5)) * CellSize;
+	const float QueryRadius = Key.Value + CellSize * UE_HALF_SQRT_3;
+
+	TArray<FOverlapResult> Overlaps;
+	GetWorld()->OverlapMultiByObjectType(Overlaps, CellCenter, FQuat::Identity,
+		FCollisionObjectQueryParams(Settings->PropagationObjectType.GetValue()),
+		FCollisionShape::MakeSphere(QueryRadius),
+		FCollisionQueryParams(SCENE_QUERY_STAT(EAReactionPropagation)));
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Overlap.GetActor()))
+		{
+			// An actor overlaps once per component
+			Candidates.AddUnique(ASC);
+		}
+	}
+	return Candidates;
+}
+
+void UEAReactionWorldSubsystem::ResetPropagation()
+{
+	PropagationQueue.Reset();
+	PropagationQueueHead = 0;
+	PropagationChains.Reset();
+	PropagationQueryCache.Reset();
+}
+
+void UEAReactionWorldSubsystem::PublishReactionEvent(const UAbilitySystemComponent& SourceASC, const UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex)
+{
+	if (!FEACombatEventStream::IsActive())
+	{
+		return;
+	}
+
+	const FElementalReactionRule& Rule = Index.GetRule(RuleIndex);
+
+	FEACombatEvent Event(EEACombatEventType::Reaction, SourceASC.GetAvatarActor(), TargetASC.GetAvatarActor());
+	Event.EffectName = Rule.ReactionEffect ? Rule.ReactionEffect->GetFName() : NAME_None;
+	Event.RuleIndex = RuleIndex;
+	Event.IndexGeneration = Index.GetGeneration();
+	FEACombatEventStream::Publish(Event);
+}
+
+void UEAReactionWorldSubsystem::ApplyReactionEffect(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FElementalReactionRule& Rule)
+{
+	EA_SCOPE_CYCLE_COUNTER(STAT_EA_ApplyReaction);
+
+	EAReactionWorld::LogReactionTriggered(Rule);
+
+	const FGameplayEffectSpecHandle SpecHandle = MakeReactionSpec(SourceASC, Rule, 1.0f);
+	if (SpecHandle.IsValid())
+	{
+		SourceASC.ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), &TargetASC);
+		INC_DWORD_STAT(STAT_EA_ReactionsApplied);
+	}
+}
+
+FGameplayEffectSpecHandle UEAReactionWorldSubsystem::MakeReactionSpec(UAbilitySystemComponent& SourceASC, const FElementalReactionRule& Rule, float Level)
+{
+	FGameplayEffectContextHandle EffectContext = SourceASC.MakeEffectContext();
+	EffectContext.AddSourceObject(SourceASC.GetAvatarActor());
+
+	FGameplayEffectSpecHandle SpecHandle = SourceASC.MakeOutgoingSpec(Rule.ReactionEffect, Level, EffectContext);
+	if (SpecHandle.IsValid())
+	{
+		// Mark this as a reaction to prevent infinite loops
+		SpecHandle.Data->AddDynamicAssetTag(FEAGameplayTags::Get().Effect_Reaction);
+	}
+	return SpecHandle;
+}
+
+FGameplayEffectSpecHandle UEAReactionWorldSubsystem::GetOrMakeReactionSpec(UAbilitySystemComponent& SourceASC, const FEAReactionIndex& Index, int32 RuleIndex, float Level)
+{
+	// Cached rule indices are meaningless for a new index
+	if (SpecCacheIndexGeneration != Index.GetGeneration())
+	{
+		for (TPair<FObjectKey, FSourceSpecCache>& Entry : SpecCache)
+		{
+			Entry.Value.Specs.Reset();
+		}
+		SpecCacheIndexGeneration = Index.GetGeneration();
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	PruneSpecCache(Now);
+
+	const FObjectKey SourceKey(&SourceASC);
+	FSourceSpecCache* SourceCache = SpecCache.Find(SourceKey);
+	if (!SourceCache)
+	{
+		SourceCache = &SpecCache.Add(SourceKey);
+		SourceCache->SourceASC = &SourceASC;
+
+		// Any tag change on the source may change what its specs capture
+		SourceCache->TagEventHandle = SourceASC.RegisterGenericGameplayTagEvent().AddWeakLambda(this, [this, SourceKey](const FGameplayTag, int32)
+		{
+			InvalidateSpecCache(SourceKey);
+		});
+	}
+
+	// Specs snapshot source attributes when built, so they are only reused within a single frame
+	if (SourceCache->SpecsFrame != GFrameCounter)
+	{
+		SourceCache->Specs.Reset();
+		SourceCache->SpecsFrame = GFrameCounter;
+	}
+	SourceCache->LastUsedTime = Now;
+
+	for (const FCachedSpec& Cached : SourceCache->Specs)
+	{
+		if (Cached.RuleIndex == RuleIndex && Cached.Level == Level)
+		{
+			return Cached.SpecHandle;
+		}
+	}
+
+	FCachedSpec& NewEntry = SourceCache->Specs.AddDefaulted_GetRef();
+	NewEntry.RuleIndex = RuleIndex;
+	NewEntry.Level = Level;
+	NewEntry.SpecHandle = MakeReactionSpec(SourceASC, Index.GetRule(RuleIndex), Level);
+	return NewEntry.SpecHandle;
+}
+
+void UEAReactionWorldSubsystem::InvalidateSpecCache(FObjectKey SourceKey)
+{
+	if (FSourceSpecCache* SourceCache = SpecCache.Find(SourceKey))
+	{
+		SourceCache->Specs.Reset();
+	}
+}
+
+void UEAReactionWorldSubsystem::PruneSpecCache(double Now)
+{
+	static constexpr double PruneInterval = 5.0;
+	if (Now - LastSpecCachePruneTime < PruneInterval)
+	{
+		return;
+	}
+	LastSpecCachePruneTime = Now;
+
+	for (auto It = SpecCache.CreateIterator(); It; ++It)
+	{
+		FSourceSpecCache& SourceCache = It.Value();
+		if (Now - SourceCache.LastUsedTime < PruneInterval && SourceCache.SourceASC.IsValid())
+		{
+			continue;
+		}
+
+		if (UAbilitySystemComponent* SourceASC = SourceCache.SourceASC.Get())
+		{
+			SourceASC->RegisterGenericGameplayTagEvent().Remove(SourceCache.TagEventHandle);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+void UEAReactionWorldSubsystem::ResetSpecCache()
+{
+	for (const TPair<FObjectKey, FSourceSpecCache>& Entry : SpecCache)
+	{
+		if (UAbilitySystemComponent* SourceASC = Entry.Value.SourceASC.Get())
+		{
+			SourceASC->RegisterGenericGameplayTagEvent().Remove(Entry.Value.TagEventHandle);
+		}
+	}
+	SpecCache.Reset();
+}
+
+bool UEAReactionWorldSubsystem::HasReactionBudget()
+{
+	if (ReactionBudgetFrame != GFrameCounter)
+	{
+		ReactionBudgetFrame = GFrameCounter;
+		ReactionsThisFrame = 0;
+	}
+
+	const int32 MaxPerFrame = GetDefault<UEAReactionSettings>()->MaxReactionsPerFrame;
+	return MaxPerFrame <= 0 || ReactionsThisFrame < MaxPerFrame;
+}
+
+bool UEAReactionWorldSubsystem::TryConsumeReactionLimits(const UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex)
+{
+	const float TargetCooldown = GetDefault<UEAReactionSettings>()->TargetReactionCooldown;
+	const float RuleCooldown = Index.GetRule(RuleIndex).InternalCooldown;
+
+	// No timestamps needed if neither cooldown applies
+	if (TargetCooldown <= 0.f && RuleCooldown <= 0.f)
+	{
+		++ReactionsThisFrame;
+		return true;
+	}
+
+	// Rule indices from an older index are meaningless
+	if (ReactionTimesIndexGeneration != Index.GetGeneration())
+	{
+		ReactionTimes.Reset();
+		ReactionTimesIndexGeneration = Index.GetGeneration();
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	PruneReactionTimes(Now);
+
+	FTargetReactionTimes& Times = ReactionTimes.FindOrAdd(FObjectKey(&TargetASC));
+	if (Now - Times.LastReactionTime < TargetCooldown)
+	{
+		return false;
+	}
+
+	TPair<int32, double>* RuleTime = Times.LastRuleTimes.FindByPredicate([RuleIndex](const TPair<int32, double>& Entry)
+	{
+		return Entry.Key == RuleIndex;
+	});
+
+	if (RuleTime && Now - RuleTime->Value < RuleCooldown)
+	{
+		return false;
+	}
+
+	Times.LastReactionTime = Now;
+	if (RuleCooldown > 0.f)
+	{
+		if (RuleTime)
+		{
+			RuleTime->Value = Now;
+		}
+		else
+		{
+			Times.LastRuleTimes.Emplace(RuleIndex, Now);
+		}
+	}
+
+	++ReactionsThisFrame;
+	return true;
+}
+
+void UEAReactionWorldSubsystem::PruneReactionTimes(double Now)
+{
+	static constexpr double PruneInterval = 5.0;
+	if (Now - LastReactionTimesPruneTime < PruneInterval)
+	{
+		return;
+	}
+	LastReactionTimesPruneTime = Now;
+
+	const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+	if (!ReactionSubsystem)
+	{
+		return;
+	}
+
+	// Entries older than every cooldown can no longer block anything
+	const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> ReactionIndex = ReactionSubsystem->GetReactionIndex();
+	const float TargetCooldown = GetDefault<UEAReactionSettings>()->TargetReactionCooldown;
+
+	for (auto It = ReactionTimes.CreateIterator(); It; ++It)
+	{
+		FTargetReactionTimes& Times = It.Value();
+		Times.LastRuleTimes.RemoveAll([&ReactionIndex, Now](const TPair<int32, double>& Entry)
+		{
+			return Entry.Key >= ReactionIndex->NumRules() || Now - Entry.Value >= ReactionIndex->GetRule(Entry.Key).InternalCooldown;
+		});
+
+		if (Times.LastRuleTimes.Num() == 0 && Now - Times.LastReactionTime >= TargetCooldown)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+namespace EAReactionWorld
+{
+	// Compares serial and parallel matching over synthetic tag sets built from the current rules
+	static void BenchmarkBatchMatching(const TArray<FString>& Args)
+	{
+		const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+		if (!ReactionSubsystem || ReactionSubsystem->GetReactionIndex()->IsEmpty())
+		{
+			UE_LOG(LogElementalArsenal, Warning, TEXT("ea.Reactions.BenchBatch: no reaction rules configured."));
+			return;
+		}
+
+		const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> Index = ReactionSubsystem->GetReactionIndex();
+		const int32 NumIterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 20;
+
+		FRandomStream Random(1234);
+		for (int32 NumPairs = 16; NumPairs <= 16384; NumPairs *= 4)
+		{
+			// Half the pairs can react, half only share a source tag
+			TArray<FGameplayTagContainer> SourceTags;
+			TArray<FGameplayTagContainer> TargetTags;
+			SourceTags.SetNum(NumPairs);
+			TargetTags.SetNum(NumPairs);
+			for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+			{
+				const FElementalReactionRule& Rule = Index->GetRule(Random.RandHelper(Index->NumRules()));
+				SourceTags[PairIndex].AddTag(Rule.SourceTag);
+				if (PairIndex % 2 == 0)
+				{
+					TargetTags[PairIndex].AddTag(Rule.TargetTag);
+				}
+			}
+
+			TArray<FEAReactionIndex::FRuleIndexArray> Results;
+			Results.SetNum(NumPairs);
+
+			auto RunPass = [&](bool bForceSingleThread)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+				{
+					ParallelFor(NumPairs, [&](int32 PairIndex)
+					{
+						Results[PairIndex].Reset();
+						Index->FindMatchingRules(SourceTags[PairIndex], TargetTags[PairIndex], Results[PairIndex]);
+					}, bForceSingleThread);
+				}
+				return (FPlatformTime::Seconds() - StartTime) / NumIterations;
+			};
+
+			const double SerialSeconds = RunPass(true);
+			const double ParallelSeconds = RunPass(false);
+
+			UE_LOG(LogElementalArsenal, Display, TEXT("BenchBatch: %6d pairs | serial %8.1f ns/pair | parallel %8.1f ns/pair | speedup %.2fx"),
+				NumPairs,
+				SerialSeconds * 1e9 / NumPairs,
+				ParallelSeconds * 1e9 / NumPairs,
+				ParallelSeconds > 0.0 ? SerialSeconds / ParallelSeconds : 0.0);
+		}
+	}
+
+	static FAutoConsoleCommand BenchBatchCommand(
+		TEXT("ea.Reactions.BenchBatch"),
+		TEXT("Measures serial vs. parallel reaction matching for growing batch sizes. Usage: ea.Reactions.BenchBatch [Iterations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkBatchMatching));
+
+	// Matches every pair of live ASCs in the world both ways: through MatchReactions, as an FEAScopedReactionBatch does,
+	// and one hit at a time like UEAAttributeSet::ProcessElementalReaction. Logs the first pair where the two disagree.
+	static void VerifyBatchMatching(const TArray<FString>& Args, UWorld* World)
+	{
+		const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+		if (!ReactionSubsystem || !World)
+		{
+			return;
+		}
+
+		const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> Index = ReactionSubsystem->GetReactionIndex();
+		const int32 MaxASCs = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 128;
+
+		TArray<UAbilitySystemComponent*> ASCs;
+		for (TObjectIterator<UAbilitySystemComponent> It; It && ASCs.Num() < MaxASCs; ++It)
+		{
+			if (It->GetWorld() == World && !It->IsTemplate())
+			{
+				ASCs.Add(*It);
+			}
+		}
+
+		TArray<FEAReactionMatchRequest> Requests;
+		Requests.Reserve(ASCs.Num() * ASCs.Num());
+		for (UAbilitySystemComponent* SourceASC : ASCs)
+		{
+			for (UAbilitySystemComponent* TargetASC : ASCs)
+			{
+				if (SourceASC != TargetASC)
+				{
+					Requests.Add({ SourceASC, TargetASC, nullptr });
+				}
+			}
+		}
+
+		// 1. Batched, forced onto ParallelFor whatever the batch size
+		TArray<FEAReactionMatch> BatchedMatches;
+		{
+			TGuardValue<int32> ForceParallel(ParallelBatchThreshold, 1);
+			UEAReactionWorldSubsystem::MatchReactions(Requests, *Index, BatchedMatches);
+		}
+
+		// 2. Unbatched, with the mask pre-filter the single-hit path applies first
+		TArray<FEAReactionMatch> UnbatchedMatches;
+		for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+		{
+			const FEAReactionMatchRequest& Request = Requests[RequestIndex];
+			if (!Index->CanReact(Index->ComputeSourceMask(*Request.SourceASC), Index->ComputeTargetMask(*Request.TargetASC)))
+			{
+				continue;
+			}
+
+			FEAReactionIndex::FRuleIndexArray RuleIndices;
+			Index->FindMatchingRules(Request.SourceASC->GetOwnedGameplayTags(), *Request.TargetASC, RuleIndices);
+			for (const int32 RuleIndex : RuleIndices)
+			{
+				UnbatchedMatches.Add({ RequestIndex, RuleIndex });
+			}
+		}
+
+		// 3. Both lists are ordered by request, then by rule priority and order
+		bool bIdentical = true;
+		const int32 NumCompared = FMath::Max(BatchedMatches.Num(), UnbatchedMatches.Num());
+		for (int32 MatchIndex = 0; MatchIndex < NumCompared; ++MatchIndex)
+		{
+			const FEAReactionMatch* Batched = BatchedMatches.IsValidIndex(MatchIndex) ? &BatchedMatches[MatchIndex] : nullptr;
+			const FEAReactionMatch* Unbatched = UnbatchedMatches.IsValidIndex(MatchIndex) ? &UnbatchedMatches[MatchIndex] : nullptr;
+			if (Batched && Unbatched && Batched->RequestIndex == Unbatched->RequestIndex && Batched->RuleIndex == Unbatched->RuleIndex)
+			{
+				continue;
+			}
+
+			// Everything after the first divergent pair is shifted, so stop there
+			const int32 RequestIndex = Batched ? Batched->RequestIndex : Unbatched->RequestIndex;
+			UE_LOG(LogElementalArsenal, Error, TEXT("VerifyBatch: %s -> %s diverges at match %d (batched rule %d, unbatched rule %d)"),
+				*GetNameSafe(Requests[RequestIndex].SourceASC->GetOwner()),
+				*GetNameSafe(Requests[RequestIndex].TargetASC->GetOwner()),
+				MatchIndex,
+				Batched ? Batched->RuleIndex : INDEX_NONE,
+				Unbatched ? Unbatched->RuleIndex : INDEX_NONE);
+			bIdentical = false;
+			break;
+		}
+
+		UE_LOG(LogElementalArsenal, Display, TEXT("VerifyBatch: %d ASCs, %d pairs, %d batched / %d unbatched matches: %s"),
+			ASCs.Num(), Requests.Num(), BatchedMatches.Num(), UnbatchedMatches.Num(), bIdentical ? TEXT("identical") : TEXT("MISMATCH"));
+	}
+
+	static FAutoConsoleCommand VerifyBatchCommand(
+		TEXT("ea.Reactions.VerifyBatch"),
+		TEXT("Matches every pair of live ASCs batched and unbatched and reports any difference. Usage: ea.Reactions.VerifyBatch [MaxASCs]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&VerifyBatchMatching));
+}
+#endif
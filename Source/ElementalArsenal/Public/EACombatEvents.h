@@ -0,0 +1,92 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include <atomic>
+#include <type_traits>
+
+enum class EEACombatEventType : uint8
+{
+	// A hit resolved by UEAAttributeSet (per hit, also with damage aggregation)
+	Damage,
+
+	// A reaction effect was applied
+	Reaction,
+};
+
+/**
+ * Compact record of one damage or reaction event. Trivially copyable so it can live in a ring buffer.
+ * The actor pointers may only be resolved on the game thread; other threads can use them as keys.
+ */
+struct FEACombatEvent
+{
+	FEACombatEvent() = default;
+
+	FEACombatEvent(EEACombatEventType InType, const AActor* InSource, const AActor* InTarget)
+		: Time(FPlatformTime::Seconds())
+		, Frame(GFrameCounter)
+		, Source(InSource)
+		, Target(InTarget)
+		, Type(InType)
+	{
+	}
+
+	// FPlatformTime::Seconds() and GFrameCounter when the event was published
+	double Time = 0.0;
+	uint64 Frame = 0;
+
+	// Avatar actors of the source and target ASCs
+	TWeakObjectPtr<const AActor> Source;
+	TWeakObjectPtr<const AActor> Target;
+
+	// Damage: the effect that dealt it. Reaction: the reaction effect.
+	FName EffectName;
+
+	// Damage: before and after resistances, and the target's health afterwards.
+	// When aggregating, one event per source and effect is published at the flush, summed over the window.
+	float RawDamage = 0.f;
+	float Damage = 0.f;
+	float HealthAfter = 0.f;
+
+	// Reaction: rule that fired, valid for the reaction index with the given generation
+	int32 RuleIndex = INDEX_NONE;
+	uint32 IndexGeneration = 0;
+
+	EEACombatEventType Type = EEACombatEventType::Damage;
+};
+
+static_assert(std::is_trivially_copyable_v<FEACombatEvent>, "FEACombatEvent is copied into ring buffers with plain stores");
+
+/**
+ * Lock-free stream of damage and reaction events for telemetry, kill feeds and combat logs.
+ *
+ * Every publishing thread writes into its own single producer / single consumer ring, allocated on that thread's
+ * first event. Publishing never locks or allocates after that; when a ring is full the event is dropped and counted.
+ * Events are only recorded while at least one consumer is registered.
+ *
+ * Consumers drain from any thread. Concurrent drains are serialized and each event is delivered once,
+ * so consumers that all need every event should share one drain and fan out.
+ */
+class ELEMENTALARSENAL_API FEACombatEventStream
+{
+public:
+	// Starts/stops recording. Calls are counted, so every RegisterConsumer needs an UnregisterConsumer.
+	static void RegisterConsumer();
+	static void UnregisterConsumer();
+
+	static bool IsActive() { return NumConsumers.load(std::memory_order_relaxed) > 0; }
+
+	// Records an event if the stream is active. Cheap no-op otherwise.
+	static void Publish(const FEACombatEvent& Event);
+
+	// Calls Visitor for up to MaxEvents pending events, oldest first per producer thread. Returns the number visited.
+	static int32 Drain(TFunctionRef<void(const FEACombatEvent&)> Visitor, int32 MaxEvents = MAX_int32);
+
+	// Events dropped because a ring was full, since startup
+	static uint64 GetNumDropped();
+
+private:
+	static std::atomic<int32> NumConsumers;
+};
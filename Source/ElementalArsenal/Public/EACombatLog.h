@@ -0,0 +1,88 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+struct FElementalReactionRule;
+
+/**
+ * Binary combat log format, shared by FEACombatRecorder and the EAReplayCombatLog commandlet.
+ *
+ * Layout: FFileHeader, NumRecords records, then the name table.
+ * Record: FRecordHeader, NumSourceTags + NumTargetTags name indices (uint32), NumMatches FMatch, NumApplied FMatch.
+ * Name table: uint32 count, then per name a uint16 byte length and its UTF-8 bytes.
+ * All fields are fixed size and little endian, so a mapped file decodes with plain copies and no parser.
+ * Records are packed back to back and are not aligned.
+ */
+namespace EACombatLog
+{
+	static constexpr uint32 Magic = 0x52434145; // "EACR"
+	static constexpr uint32 Version = 2;
+
+	// Name index of a missing name (e.g. a hit from a source without an effect)
+	static constexpr uint32 NoName = MAX_uint32;
+
+	// NumApplied of a hit matched in an FEAScopedReactionBatch, whose reactions are resolved with the whole batch
+	static constexpr uint16 AppliedUnknown = MAX_uint16;
+
+	struct FFileHeader
+	{
+		uint32 Magic = EACombatLog::Magic;
+		uint32 Version = EACombatLog::Version;
+		uint64 NumRecords = 0;
+		uint64 NameTableOffset = 0;
+	};
+
+	// One reaction decision: the inputs of the hit, the rules the index matched for it (what a replay reproduces),
+	// and the reactions that were then applied or queued, after the self-reaction guard, cooldowns and frame budget
+	struct FRecordHeader
+	{
+		uint64 Frame = 0;
+		float Damage = 0.f;
+		uint32 DamageEffect = NoName;
+		uint16 NumSourceTags = 0;
+		uint16 NumTargetTags = 0;
+		uint16 NumMatches = 0;
+		uint16 NumApplied = 0;
+	};
+
+	// A matched rule, identified by content since rule indices differ between rule sets
+	struct FMatch
+	{
+		uint32 SourceTag = NoName;
+		uint32 TargetTag = NoName;
+		uint32 ReactionEffect = NoName;
+
+		bool operator==(const FMatch& Other) const { return SourceTag == Other.SourceTag && TargetTag == Other.TargetTag && ReactionEffect == Other.ReactionEffect; }
+		bool operator<(const FMatch& Other) const
+		{
+			return SourceTag != Other.SourceTag ? SourceTag < Other.SourceTag : (TargetTag != Other.TargetTag ? TargetTag < Other.TargetTag : ReactionEffect < Other.ReactionEffect);
+		}
+	};
+
+	static_assert(sizeof(FFileHeader) == 24 && sizeof(FRecordHeader) == 24 && sizeof(FMatch) == 12, "Combat log layout changed, bump EACombatLog::Version");
+}
+
+/**
+ * Records every reaction decision to a binary combat log (see EACombatLog).
+ * Records are appended to a memory buffer on the game thread and written to disk in the background,
+ * so recording does not wait on file I/O. Console: ea.CombatLog.Start [File], ea.CombatLog.Stop.
+ */
+class ELEMENTALARSENAL_API FEACombatRecorder
+{
+public:
+	// Starts a recording. Defaults to Saved/CombatLogs/<date>.eacr. False if already recording or the file cannot be created.
+	static bool Start(const FString& FilePath = FString());
+
+	// Writes the name table and header and closes the file. Also called on exit, so an unfinished recording stays replayable.
+	static void Stop();
+
+	static bool IsRecording();
+
+	// Appends one decision: the index's matches for the hit and the reactions applied from them. Tags are those the
+	// hit was matched with, before any reaction changed them. Pass bAppliedKnown = false for batched hits. Game thread only.
+	static void RecordDecision(const FGameplayTagContainer& SourceTags, const FGameplayTagContainer& TargetTags, const UClass* DamageEffect, float Damage,
+		TConstArrayView<const FElementalReactionRule*> Matches, TConstArrayView<const FElementalReactionRule*> Applied, bool bAppliedKnown);
+};
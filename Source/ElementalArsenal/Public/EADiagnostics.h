@@ -0,0 +1,55 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// On-screen diagnostics are compiled out of Test and Shipping builds
+#ifndef EA_WITH_DIAGNOSTICS
+#define EA_WITH_DIAGNOSTICS (!(UE_BUILD_SHIPPING || UE_BUILD_TEST))
+#endif
+
+// stat ElementalArsenal
+DECLARE_STATS_GROUP(TEXT("ElementalArsenal"), STATGROUP_ElementalArsenal, STATCAT_Advanced);
+
+// Per-frame counters. Also visible in Unreal Insights with the stats trace channel (-trace=default,stats).
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rules Evaluated"), STAT_EA_RulesEvaluated, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reactions Matched"), STAT_EA_ReactionsMatched, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reactions Applied"), STAT_EA_ReactionsApplied, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reactions Propagated"), STAT_EA_ReactionsPropagated, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reactions Suppressed"), STAT_EA_ReactionsSuppressed, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Equips (Sync Visuals)"), STAT_EA_EquipsSync, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Equips (Async Visuals)"), STAT_EA_EquipsAsync, STATGROUP_ElementalArsenal, ELEMENTALARSENAL_API);
+
+// Cycle stat plus a CPU trace scope of the same name, so hot paths show up in Insights without stat named events
+#define EA_SCOPE_CYCLE_COUNTER(Stat) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	SCOPE_CYCLE_COUNTER(Stat)
+
+#if EA_WITH_DIAGNOSTICS
+
+namespace EADiagnostics
+{
+	// True while ea.Debug.Overlay is set
+	ELEMENTALARSENAL_API bool IsOverlayEnabled();
+
+	ELEMENTALARSENAL_API void AddOverlayMessage(const FColor& Color, const FString& Message);
+}
+
+// Shows an on-screen message while ea.Debug.Overlay is set. The message is not formatted otherwise.
+#define EA_DEBUG_OVERLAY(Color, Format, ...) \
+	do \
+	{ \
+		if (EADiagnostics::IsOverlayEnabled()) \
+		{ \
+			EADiagnostics::AddOverlayMessage(Color, FString::Printf(Format, ##__VA_ARGS__)); \
+		} \
+	} while (0)
+
+#else
+
+#define EA_DEBUG_OVERLAY(Color, Format, ...) do {} while (0)
+
+#endif
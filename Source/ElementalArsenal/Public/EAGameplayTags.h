@@ -0,0 +1,44 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+/**
+ * Native gameplay tags used by the Elemental Arsenal plugin.
+ * Registered once in FElementalArsenalModule::StartupModule so hot paths can read them directly
+ * instead of resolving them by name.
+ */
+struct ELEMENTALARSENAL_API FEAGameplayTags
+{
+public:
+	static const FEAGameplayTags& Get() { return GameplayTags; }
+
+	// Registers all native tags and verifies they resolved. Fatal on failure.
+	static void InitializeNativeTags();
+
+	// Added to reaction effects to prevent infinite recursion loops
+	FGameplayTag Effect_Reaction;
+
+	// Damage elements, matching the typed incoming damage attributes on UEAAttributeSet
+	FGameplayTag Element_Fire;
+	FGameplayTag Element_Ice;
+	FGameplayTag Element_Lightning;
+
+	// Equipment slots. Designers can add more children of Equipment.Slot.
+	FGameplayTag Equipment_Slot_MainHand;
+	FGameplayTag Equipment_Slot_OffHand;
+	FGameplayTag Equipment_Slot_Armor;
+	FGameplayTag Equipment_Slot_Trinket;
+
+private:
+	void AddAllTags();
+	void AddTag(FGameplayTag& OutTag, const ANSICHAR* TagName, const ANSICHAR* TagComment);
+	void ValidateAllTags() const;
+
+	// Every registered tag with its name, used for validation
+	TArray<TPair<FName, const FGameplayTag*>> RegisteredTags;
+
+	static FEAGameplayTags GameplayTags;
+};
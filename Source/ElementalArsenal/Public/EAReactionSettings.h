@@ -3,10 +3,14 @@
 #pragma once
 
 #include "Engine/DeveloperSettings.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/EngineTypes.h"
 #include "Gas/EAReactionTypes.h"
 
 #include "EAReactionSettings.generated.h"
 
+class UEAReactionRuleSet;
+
 /**
  * Global settings for the Elemental Arsenal plugin.
  * Configurable in Project Settings -> Game -> Elemental Arsenal.
@@ -20,4 +24,79 @@ public:
 	// List of all active elemental reactions in the game
 	UPROPERTY(Config, EditAnywhere, Category = "Reactions", meta = (TitleProperty = "ReactionEffect"))
 	TArray<FElementalReactionRule> ReactionRules;
+
+	// Rule sets always merged into the reaction index. Game features and maps can register more at runtime.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions")
+	TArray<TSoftObjectPtr<UEAReactionRuleSet>> DefaultRuleSets;
+
+	// If true, matched reactions are queued per world and applied in one batch per frame
+	// instead of inside PostGameplayEffectExecute. Duplicate target/rule pairs within a frame are merged.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Performance")
+	bool bDeferReactions = false;
+
+	// Tick group in which the deferred reaction queue is flushed
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Performance", meta = (EditCondition = "bDeferReactions"))
+	TEnumAsByte<ETickingGroup> ReactionFlushTickGroup = TG_PostPhysics;
+
+	// Maximum deferred reactions applied per flush. The rest carry over to the next frame. 0 = unlimited.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Performance", meta = (EditCondition = "bDeferReactions", ClampMin = "0"))
+	int32 MaxDeferredReactionsPerFlush = 0;
+
+	// Reuse one outgoing reaction spec per source, rule and level within a frame instead of building one per hit.
+	// Cached specs are dropped at the end of the frame and whenever the source's tags change. Each target gets its own
+	// copy of the effect context.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Performance")
+	bool bCacheReactionSpecs = true;
+
+	// If true, damage on a UEAAttributeSet is collected per source and damage effect and applied to Health in one step
+	// per window, followed by one reaction lookup per source and effect. Meant for beams, DoTs and shotguns.
+	// Health lags behind the hits by up to one window.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Performance")
+	bool bAggregateDamage = false;
+
+	// Length of a damage aggregation window in seconds. 0 = resolve on the next frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Performance", meta = (EditCondition = "bAggregateDamage", ClampMin = "0.0", Units = "s"))
+	float DamageAggregationWindow = 0.f;
+
+	// Minimum time in seconds between any two reactions on the same target. 0 = no limit.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Limits", meta = (ClampMin = "0.0", Units = "s"))
+	float TargetReactionCooldown = 0.f;
+
+	// Maximum reactions applied per world per frame. Deferred reactions over budget wait for the next frame,
+	// immediate ones are dropped. 0 = unlimited.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Limits", meta = (ClampMin = "0"))
+	int32 MaxReactionsPerFrame = 0;
+
+	// Time per frame the spreading reaction scheduler may spend. The rest of a chain continues next frame. 0 = unlimited.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Propagation", meta = (ClampMin = "0.0", Units = "ms"))
+	float PropagationBudgetMs = 0.5f;
+
+	// Maximum spreading reactions applied per world per frame. 0 = unlimited.
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Propagation", meta = (ClampMin = "0"))
+	int32 MaxPropagationsPerFrame = 128;
+
+	// Object type overlapped when looking for targets a reaction can spread to
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Propagation")
+	TEnumAsByte<ECollisionChannel> PropagationObjectType = ECC_Pawn;
+
+	// Overlap queries are cached per frame on a grid of this size, so a chain spreading through a crowd
+	// reuses one query per cell instead of one per target
+	UPROPERTY(Config, EditAnywhere, Category = "Reactions|Propagation", meta = (ClampMin = "10.0", Units = "cm"))
+	float PropagationQueryCellSize = 200.f;
+
+	// Memory budget for preloaded equipment (meshes and ability classes). Least recently used loadouts are evicted first.
+	UPROPERTY(Config, EditAnywhere, Category = "Equipment", meta = (ClampMin = "0.0", Units = "MB"))
+	float EquipmentPreloadBudgetMB = 256.f;
+
+	// Skeletal mesh equipment actors spawned into each game world's pool at begin play
+	UPROPERTY(Config, EditAnywhere, Category = "Equipment|Pooling", meta = (ClampMin = "0"))
+	int32 PrewarmSkeletalEquipmentActors = 0;
+
+	// Static mesh equipment actors spawned into each game world's pool at begin play
+	UPROPERTY(Config, EditAnywhere, Category = "Equipment|Pooling", meta = (ClampMin = "0"))
+	int32 PrewarmStaticEquipmentActors = 0;
+
+	// Maximum free actors kept per mesh type. Released actors beyond this are destroyed.
+	UPROPERTY(Config, EditAnywhere, Category = "Equipment|Pooling", meta = (ClampMin = "0"))
+	int32 MaxPooledEquipmentActors = 256;
 };
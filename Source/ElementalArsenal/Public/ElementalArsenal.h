@@ -5,7 +5,12 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+// Shipping compiles out everything below Warning, so per-equip/per-reaction logging costs nothing there
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogElementalArsenal, Log, Warning);
+#else
 DECLARE_LOG_CATEGORY_EXTERN(LogElementalArsenal, Log, All);
+#endif
 
 class FElementalArsenalModule : public IModuleInterface
 {
@@ -13,4 +18,7 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle PreExitHandle;
 };
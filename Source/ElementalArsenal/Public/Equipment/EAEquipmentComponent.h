@@ -5,49 +5,240 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "GameplayAbilitySpecHandle.h"
+#include "GameplayTagContainer.h"
+#include "Engine/StreamableManager.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "EAEquipmentComponent.generated.h"
 
 class UEAEquipmentDefinition;
 class UAbilitySystemComponent;
+class UMeshComponent;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+class USceneComponent;
+class UEAEquipmentComponent;
+
+// EquipmentActor is null in Component mode
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FEAOnEquipmentVisualsReady, const UEAEquipmentDefinition*, ItemDef, AActor*, EquipmentActor, UMeshComponent*, EquipmentMesh);
+
+UENUM(BlueprintType)
+enum class EEAEquipmentVisualMode : uint8
+{
+	// Spawn (or take from the pool) a separate mesh actor per item
+	Actor,
+	// Attach a reused mesh component directly to the owner. Cheaper in crowds.
+	Component
+};
+
+/** State of one equipment slot. Kept after unequip so its visual components can be reused. */
+USTRUCT()
+struct FEAEquippedSlot
+{
+	GENERATED_BODY()
+
+	// The definition in this slot, null if empty
+	UPROPERTY()
+	TObjectPtr<const UEAEquipmentDefinition> ItemDef = nullptr;
+
+	// Actor mode: the (pooled) mesh actor
+	UPROPERTY()
+	TObjectPtr<AActor> SpawnedActor = nullptr;
+
+	// Component mode: mesh components created on first use and reused across equips
+	UPROPERTY()
+	TObjectPtr<USkeletalMeshComponent> SkeletalVisualComponent = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UStaticMeshComponent> StaticVisualComponent = nullptr;
+
+	// Component mode: the one currently showing an item
+	UPROPERTY()
+	TObjectPtr<UMeshComponent> ActiveVisualComponent = nullptr;
+
+	// In-flight mesh load for ItemDef. Cancelled if the slot is swapped mid-load.
+	TSharedPtr<FStreamableHandle> PendingVisualsHandle;
+
+	// Clients only: in-flight load of a replicated definition that is not resident yet
+	TSharedPtr<FStreamableHandle> PendingDefinitionHandle;
+};
+
+/** Replicated state of one slot. Only the slot tag and the definition's primary asset id go over the wire. */
+USTRUCT()
+struct FEAReplicatedSlotEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag SlotTag;
+
+	// Invalid while the slot is empty
+	UPROPERTY()
+	FPrimaryAssetId ItemId;
+
+	void PreReplicatedRemove(const struct FEAReplicatedSlotList& InArraySerializer);
+	void PostReplicatedAdd(const struct FEAReplicatedSlotList& InArraySerializer);
+	void PostReplicatedChange(const struct FEAReplicatedSlotList& InArraySerializer);
+};
+
+/** Server-authoritative slot list. Delta serialized, so an equip change only sends the entry that changed. */
+USTRUCT()
+struct FEAReplicatedSlotList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FEAReplicatedSlotEntry> Entries;
+
+	// Component to notify when entries arrive on a client
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UEAEquipmentComponent> OwnerComponent = nullptr;
+
+	// Writes the slot's item and marks the entry dirty. Returns false if nothing changed.
+	bool SetSlot(const FGameplayTag& SlotTag, const FPrimaryAssetId& ItemId);
+
+	const FEAReplicatedSlotEntry* FindSlot(const FGameplayTag& SlotTag) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FEAReplicatedSlotEntry, FEAReplicatedSlotList>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FEAReplicatedSlotList> : public TStructOpsTypeTraitsBase2<FEAReplicatedSlotList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ELEMENTALARSENAL_API UEAEquipmentComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
-public:	
+public:
 	UEAEquipmentComponent();
 
-	// Equips a new item, destroying the old one if it exists
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Equips an item into its own slot (UEAEquipmentDefinition::EquipSlot), replacing what was there.
+	// Equipment is server authoritative: on clients this only logs a warning.
 	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
 	void EquipItem(const UEAEquipmentDefinition* ItemDef);
 
-	// Unequips the current item
+	// Equips an item into the given slot. Only abilities and tags that differ from the previous item
+	// are granted or revoked; shared abilities keep their spec.
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void EquipItemInSlot(FGameplayTag Slot, const UEAEquipmentDefinition* ItemDef);
+
+	// Unequips every slot
 	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
 	void UnequipItem();
 
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void UnequipSlot(FGameplayTag Slot);
+
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	const UEAEquipmentDefinition* GetEquippedItem(FGameplayTag Slot) const;
+
+	// The main hand actor
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	AActor* GetSpawnedEquipmentActor() const;
+
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	AActor* GetSpawnedEquipmentActorInSlot(FGameplayTag Slot) const;
+
+	// The mesh showing the slot's item, in either visual mode
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	UMeshComponent* GetEquipmentMeshComponent(FGameplayTag Slot) const;
+
+	// How the equipped items are shown. Takes effect on the next equip.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Elemental Arsenal|Equipment")
+	EEAEquipmentVisualMode VisualMode = EEAEquipmentVisualMode::Actor;
+
+	// Component mode only: let the attached mesh components tick (e.g. animated skeletal weapons)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Elemental Arsenal|Equipment", meta = (EditCondition = "VisualMode == EEAEquipmentVisualMode::Component"))
+	bool bTickVisualComponent = false;
+
+	// True while any slot's mesh is still streaming in
 	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
-	AActor* GetSpawnedEquipmentActor() const { return SpawnedEquipmentMesh; }
+	bool IsLoadingVisuals() const;
+
+	// Broadcast once an equipped item's visual has been spawned and attached
+	UPROPERTY(BlueprintAssignable, Category = "Elemental Arsenal|Equipment")
+	FEAOnEquipmentVisualsReady OnEquipmentVisualsReady;
+
+	// If true, meshes that are not resident are streamed in asynchronously. Abilities and tags are granted
+	// immediately and the visual is attached when the load completes. If false, meshes are loaded synchronously.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Elemental Arsenal|Equipment")
+	bool bLoadVisualsAsync = true;
 
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-	// The currently equipped definition
-	UPROPERTY()
-	const UEAEquipmentDefinition* CurrentEquipmentDef;
+	friend struct FEAReplicatedSlotEntry;
 
-	// The actual spawned mesh actor (could be a full actor, but for simplicity we assume we might just spawn a mesh or a lightweight actor. 
-	// For this portfolio piece, let's spawn a simple StaticMeshActor or just attach a component. 
-	// Actually, best practice is usually to spawn an Actor so it can have its own logic, but let's keep it simple: 
-	// We'll spawn a SkeletalMeshComponent attached to the owner.)
-	// Wait, if we want it to be separate, spawning an Actor is cleaner.
+	// What every machine needs to build the equipment locally
+	UPROPERTY(Replicated)
+	FEAReplicatedSlotList ReplicatedSlots;
+
+	// Slot tag -> slot state
 	UPROPERTY()
-	AActor* SpawnedEquipmentMesh;
+	TMap<FGameplayTag, FEAEquippedSlot> EquippedSlots;
+
+	// An ability granted by one or more slots. Definitions hold hard references to the classes.
+	struct FGrantedAbility
+	{
+		FGameplayAbilitySpecHandle Handle;
+		int32 RefCount = 0;
+	};
 
 	// Handles to the granted abilities, so we can remove them later
-	TArray<FGameplayAbilitySpecHandle> GrantedAbilityHandles;
+	TMap<const UClass*, FGrantedAbility> GrantedAbilities;
+
+	// Local part of an equip: visuals, tags, and (with authority) abilities. ItemDef may be null.
+	void SetSlotItem(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef);
+
+	// Server: writes the slot into ReplicatedSlots
+	void ReplicateSlot(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef);
+
+	// Returns false (and warns) if the owner is not the authority
+	bool CanModifyEquipment(const TCHAR* Context) const;
+
+	// Client: resolves the replicated definition id (loading it if needed) and equips it locally
+	void OnSlotReplicated(FGameplayTag SlotTag, const FPrimaryAssetId& ItemId);
+	void OnReplicatedItemLoaded(FGameplayTag SlotTag, FPrimaryAssetId ItemId);
+
+	// Grants/revokes only the abilities and tags that differ between the two definitions (either may be null).
+	// Abilities are only touched with authority; their specs replicate through the ASC.
+	void ApplyGameplayDiff(const UEAEquipmentDefinition* OldDef, const UEAEquipmentDefinition* NewDef);
+
+	// Starts loading (or directly spawns) the slot's visual
+	void LoadSlotVisuals(FGameplayTag SlotTag);
+
+	// Spawns and attaches the mesh of the slot's item. Assumes its mesh is already loaded.
+	void SpawnEquipmentVisuals(FGameplayTag SlotTag);
+
+	// Component mode counterpart of the actor spawning in SpawnEquipmentVisuals
+	void AttachVisualComponent(FEAEquippedSlot& Slot);
+
+	// Returns the slot's actor to the pool and hides its components
+	void ReleaseSlotVisuals(FEAEquippedSlot& Slot);
+
+	// Template for new visual components: no collision, no overlaps, tick per bTickVisualComponent
+	void InitVisualComponent(UMeshComponent* MeshComponent) const;
+
+	// Where visuals attach: the character mesh, or the owner's root
+	USceneComponent* GetVisualAttachParent() const;
+
+	void OnVisualsLoaded(FGameplayTag SlotTag, const UEAEquipmentDefinition* ItemDef, bool bFallback);
+
+	// True when the skeletal mesh is set but failed to load and the static mesh still needs streaming
+	static bool NeedsStaticMeshFallback(const UEAEquipmentDefinition* ItemDef);
 
 	// Helper to get Owner's ASC
 	UAbilitySystemComponent* GetAbilitySystemComponent() const;
@@ -14,9 +14,10 @@ class UStaticMesh;
 /**
  * Defines a piece of equipment in the Elemental Arsenal system.
  * Contains visuals, gameplay tags (Elements), and abilities to grant.
+ * A primary asset, so equipment replicates as its FPrimaryAssetId.
  */
 UCLASS(BlueprintType, Const)
-class ELEMENTALARSENAL_API UEAEquipmentDefinition : public UDataAsset
+class ELEMENTALARSENAL_API UEAEquipmentDefinition : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
@@ -33,6 +34,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Visuals")
 	FName AttachSocketName;
 
+	// Slot this item occupies (e.g., Equipment.Slot.MainHand). Empty means main hand.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gameplay", meta = (Categories = "Equipment.Slot"))
+	FGameplayTag EquipSlot;
+
 	// Abilities to grant to the wearer when equipped
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gameplay")
 	TArray<TSubclassOf<UGameplayAbility>> AbilitiesToGrant;
@@ -40,4 +45,7 @@ public:
 	// Tags to apply to the owner (e.g., Element.Fire, Equipment.Type.Sword)
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gameplay")
 	FGameplayTagContainer EquipmentTags;
+
+	// EquipSlot, or the main hand slot if none is set
+	FGameplayTag GetEquipSlot() const;
 };
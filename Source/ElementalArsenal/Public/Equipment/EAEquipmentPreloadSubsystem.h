@@ -0,0 +1,102 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "EAEquipmentPreloadSubsystem.generated.h"
+
+class UEAEquipmentDefinition;
+
+/** Hit/miss counters of the equipment warm cache, used to size the preload budget. */
+USTRUCT(BlueprintType)
+struct FEAEquipmentPreloadStats
+{
+	GENERATED_BODY()
+
+	// Equips whose definition was already resident in the cache
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 Hits = 0;
+
+	// Equips that had to wait on a load
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 Misses = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 Evictions = 0;
+
+	// Fully loaded entries. Entries still streaming in are not counted, here or in ResidentBytes.
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 NumResident = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int64 ResidentBytes = 0;
+};
+
+/**
+ * Streams in equipment definitions, then their meshes, and keeps them and their ability classes resident through
+ * streamable handles, so cycling through a loadout never waits on disk. Entries are evicted least-recently-used
+ * first once the budget in the project settings is exceeded.
+ */
+UCLASS()
+class ELEMENTALARSENAL_API UEAEquipmentPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Streams in every definition of the loadout, then its meshes, and keeps them resident
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void PreloadLoadout(const TArray<TSoftObjectPtr<UEAEquipmentDefinition>>& Loadout);
+
+	// Releases a preloaded definition
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void ReleaseDefinition(const UEAEquipmentDefinition* ItemDef);
+
+	// Releases everything
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void ReleaseAll();
+
+	// True if the definition is cached and fully loaded
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	bool IsResident(const UEAEquipmentDefinition* ItemDef) const;
+
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	FEAEquipmentPreloadStats GetStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void ResetStats();
+
+	// Called by the equipment component on every equip. Records a hit or miss and refreshes the LRU position.
+	void NotifyEquipped(const UEAEquipmentDefinition* ItemDef);
+
+	// Returns the subsystem of the world's game instance, if any
+	static UEAEquipmentPreloadSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	struct FPreloadEntry
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		int64 Bytes = 0;
+		uint64 LastUsed = 0;
+
+		// Everything has loaded and Bytes is counted in the stats. Only resident entries are evicted.
+		bool bResident = false;
+	};
+
+	// Two stages: the definition, then the assets it references
+	void OnDefinitionLoaded(FSoftObjectPath DefinitionPath);
+	void OnEntryLoaded(FSoftObjectPath DefinitionPath);
+	void EnforceBudget(const FSoftObjectPath& KeepPath);
+	void RemoveEntry(const FSoftObjectPath& DefinitionPath);
+
+	static int64 EstimateBytes(const FStreamableHandle& Handle);
+
+	// Keyed by definition path so the cache does not depend on the definition object staying alive
+	TMap<FSoftObjectPath, FPreloadEntry> Entries;
+
+	uint64 UseCounter = 0;
+	FEAEquipmentPreloadStats Stats;
+};
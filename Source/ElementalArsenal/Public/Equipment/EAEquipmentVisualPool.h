@@ -0,0 +1,82 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EAEquipmentVisualPool.generated.h"
+
+class ASkeletalMeshActor;
+class AStaticMeshActor;
+
+/** Counters of the equipment visual pool. */
+USTRUCT(BlueprintType)
+struct FEAEquipmentVisualPoolStats
+{
+	GENERATED_BODY()
+
+	// Actors created because the pool was empty (includes prewarm)
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 Spawned = 0;
+
+	// Acquires served from the pool
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 Reused = 0;
+
+	// Released actors destroyed because the pool was full
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 Destroyed = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 FreeSkeletal = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	int32 FreeStatic = 0;
+};
+
+/**
+ * Per-world pool of equipment mesh actors.
+ * Actors are configured once (no collision, no overlaps) and then hidden and detached on release
+ * instead of being destroyed, so weapon swaps do not spawn actors or produce garbage.
+ */
+UCLASS()
+class ELEMENTALARSENAL_API UEAEquipmentVisualPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Returns a visible, unattached actor owned by Owner
+	ASkeletalMeshActor* AcquireSkeletalMeshActor(AActor* Owner);
+	AStaticMeshActor* AcquireStaticMeshActor(AActor* Owner);
+
+	// Hides and detaches the actor and returns it to the pool
+	void ReleaseActor(AActor* Actor);
+
+	// Fills the pools up to the given number of free actors
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Equipment")
+	void Prewarm(int32 NumSkeletal, int32 NumStatic);
+
+	UFUNCTION(BlueprintPure, Category = "Elemental Arsenal|Equipment")
+	FEAEquipmentVisualPoolStats GetStats() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	template<typename ActorType>
+	ActorType* SpawnPooledActor();
+
+	template<typename ActorType>
+	ActorType* AcquireFromPool(TArray<TObjectPtr<ActorType>>& FreeActors, AActor* Owner);
+
+	UPROPERTY()
+	TArray<TObjectPtr<ASkeletalMeshActor>> FreeSkeletalActors;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AStaticMeshActor>> FreeStaticActors;
+
+	FEAEquipmentVisualPoolStats Stats;
+};
@@ -4,8 +4,11 @@
 
 #include "AttributeSet.h"
 #include "AbilitySystemComponent.h"
+#include "Engine/TimerHandle.h"
 #include "EAAttributeSet.generated.h"
 
+class FEAReactionIndex;
+
 // Macro for defining getters/setters
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
 	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
@@ -22,6 +25,11 @@ public:
 	UEAAttributeSet();
 
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
+	virtual void BeginDestroy() override;
+
+	// Returns bitmasks of the reactive tags our ASC owns, in the bit space of the given index.
+	// The masks are kept current through tag events and rebuilt when the index changes.
+	void GetReactiveTagMasks(const TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe>& Index, uint64& OutSourceMask, uint64& OutTargetMask);
 
 	// --- Attributes ---
 
@@ -38,10 +46,93 @@ public:
 	FGameplayAttributeData IncomingDamage;
 	ATTRIBUTE_ACCESSORS(UEAAttributeSet, IncomingDamage)
 
+	// Typed incoming damage meta attributes. Reduced by the matching resistance, then applied together with IncomingDamage.
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData IncomingFireDamage;
+	ATTRIBUTE_ACCESSORS(UEAAttributeSet, IncomingFireDamage)
+
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData IncomingIceDamage;
+	ATTRIBUTE_ACCESSORS(UEAAttributeSet, IncomingIceDamage)
+
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData IncomingLightningDamage;
+	ATTRIBUTE_ACCESSORS(UEAAttributeSet, IncomingLightningDamage)
+
+	// Fraction of typed damage ignored. 1 = immune, negative values make the target take extra damage.
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData FireResistance;
+	ATTRIBUTE_ACCESSORS(UEAAttributeSet, FireResistance)
+
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData IceResistance;
+	ATTRIBUTE_ACCESSORS(UEAAttributeSet, IceResistance)
+
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData LightningResistance;
+	ATTRIBUTE_ACCESSORS(UEAAttributeSet, LightningResistance)
+
+	// True for IncomingDamage and the typed incoming damage attributes
+	static bool IsIncomingDamageAttribute(const FGameplayAttribute& Attribute);
+
 protected:
-	// Helper to handle reactions
-	void ProcessElementalReaction(const FGameplayEffectModCallbackData& Data);
+	// Consumes the incoming damage meta attributes, applies resistances and health, then looks up reactions.
+	// Runs once per damage modifier; replaces per-element execution calculations.
+	void ResolveIncomingDamage(const FGameplayEffectModCallbackData& Data);
+
+	// Applies already mitigated damage to Health
+	void ApplyMitigatedDamage(float MitigatedDamage);
+
+	// Helper to handle reactions. SourceEffectClass is the effect that dealt the damage; Damage is only recorded.
+	void ProcessElementalReaction(UAbilitySystemComponent* SourceASC, const UClass* SourceEffectClass, float Damage);
+
+	// Adds a hit to the aggregation window, starting the window if needed (bAggregateDamage)
+	void AggregateDamage(const FGameplayEffectModCallbackData& Data, float RawDamage, float MitigatedDamage);
+
+	// Resolves the window: one Health change, then one damage event and one reaction lookup per source and effect
+	void FlushAggregatedDamage();
 
 	// Guard to prevent infinite recursion during reaction processing
 	bool bIsProcessingReaction;
+
+	// GAS calls PostGameplayEffectExecute once per damage modifier and execution output. True only for the first call
+	// of each execution of Spec, so an effect looks up reactions once however many damage modifiers it has.
+	bool TryBeginSpecReaction(const FGameplayEffectSpec& Spec);
+
+	// Damage collected in the current aggregation window, per source and damage effect
+	struct FAggregatedDamage
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+		TWeakObjectPtr<const AActor> SourceAvatar;
+		const UClass* EffectClass = nullptr;
+		float RawDamage = 0.f;
+		float MitigatedDamage = 0.f;
+	};
+	TArray<FAggregatedDamage, TInlineAllocator<2>> AggregatedDamage;
+	FTimerHandle AggregationTimerHandle;
+
+private:
+	void OnReactiveTagChanged(const FGameplayTag Tag, int32 NewCount);
+	void UnbindReactiveTagEvents();
+
+	// Reactive tag masks of the owning ASC, valid for ReactiveMaskIndex only
+	uint64 ReactiveSourceMask;
+	uint64 ReactiveTargetMask;
+	TSharedPtr<const FEAReactionIndex, ESPMode::ThreadSafe> ReactiveMaskIndex;
+
+	TWeakObjectPtr<UAbilitySystemComponent> ReactiveMaskASC;
+	FDelegateHandle ReactiveTagEventHandle;
+
+	// Called by the owning ASC after an instant or periodic execution, while the executed spec is still alive
+	void OnSpecExecuted(UAbilitySystemComponent* ASC, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+	void UnbindExecuteEvents();
+
+	// Specs whose current execution already looked up reactions. Several when a reaction executes another effect
+	// on this target mid-execution. Compared by address only, and removed before the spec is freed.
+	TArray<const FGameplayEffectSpec*, TInlineAllocator<2>> ReactedSpecs;
+	uint64 ReactedSpecsFrame = 0;
+
+	TWeakObjectPtr<UAbilitySystemComponent> ExecuteEventsASC;
+	FDelegateHandle AppliedEventHandle;
+	FDelegateHandle PeriodicEventHandle;
 };
@@ -0,0 +1,184 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Gas/EAReactionTypes.h"
+#include "Gas/EAReactionRuleSet.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * Compiled, read-only view of the reaction rules.
+ * Rules are grouped by SourceTag, then by TargetTag, so a lookup only visits the rules
+ * reachable from the tags the source actually owns. Child tags are expanded at build time,
+ * so owning "Element.Fire.Blue" reaches the bucket of an "Element.Fire" rule.
+ *
+ * Each distinct SourceTag and TargetTag also gets a bit, so an ASC can carry a bitmask of the
+ * "reactive" tags it owns and most hits can be rejected with a couple of bit operations.
+ *
+ * Rule conditions, priorities and exclusivity groups are compiled as well: every condition tag gets a bit,
+ * each rule becomes three masks per side, and a hit queries each condition tag at most once. Matching
+ * therefore costs at most one query per condition tag plus a few bit operations per candidate rule.
+ *
+ * Instances are immutable once built and shared through a thread-safe reference.
+ */
+class ELEMENTALARSENAL_API FEAReactionIndex
+{
+public:
+	using FRuleIndexArray = TArray<int32, TInlineAllocator<8>>;
+
+	// Everything Build reads from the rule sets and the gameplay tag tree, copied out as plain data
+	struct FBuildInput
+	{
+		struct FRuleSetRange
+		{
+			int32 RuleOffset = 0;
+			int32 NumRules = 0;
+			TArray<FEAReactionRuleBucket> CompiledBuckets;
+		};
+
+		// Project rules followed by the rules of each set
+		TArray<FElementalReactionRule> Rules;
+		int32 NumProjectRules = 0;
+		TArray<FRuleSetRange> RuleSets;
+
+		// Every rule SourceTag -> its child tags
+		TMap<FGameplayTag, FGameplayTagContainer> SourceTagChildren;
+	};
+
+	// Game thread only: reads the rule set UObjects and UGameplayTagsManager
+	static FBuildInput GatherBuildInput(const TArray<FElementalReactionRule>& InRules, TConstArrayView<const UEAReactionRuleSet*> RuleSets = {});
+
+	// Compiles the gathered rules in order. Touches no UObject or tag manager state, so it is safe on a worker.
+	// Invalid rules (missing tags or effect) are kept for index stability but never match.
+	// A duplicate of an earlier rule (FElementalReactionRule::IsDuplicateOf) is dropped.
+	static TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> Build(const FBuildInput& Input);
+
+	// Gathers and compiles in one go, on the game thread
+	static TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> Build(const TArray<FElementalReactionRule>& InRules, TConstArrayView<const UEAReactionRuleSet*> RuleSets = {})
+	{
+		return Build(GatherBuildInput(InRules, RuleSets));
+	}
+
+	// Appends the indices of the rules that fire for the given tag sets: conditions pass and, per exclusivity group,
+	// only the winner. Ordered by priority, then rule order.
+	void FindMatchingRules(const FGameplayTagContainer& SourceTags, const FGameplayTagContainer& TargetTags, FRuleIndexArray& OutRuleIndices) const;
+
+	// Same as above, but queries the target's tag count map directly instead of a tag container
+	void FindMatchingRules(const FGameplayTagContainer& SourceTags, const UAbilitySystemComponent& TargetASC, FRuleIndexArray& OutRuleIndices) const;
+
+	// True if the target owns the rule's TargetTag and passes its target conditions. Used for spreading reactions.
+	bool CanRuleReactWith(int32 RuleIndex, const UAbilitySystemComponent& TargetASC) const;
+
+	// Bit of each reactive tag in the source/target mask space. Does not include children;
+	// ASC tag events already fire for parent tags when a child is added.
+	uint64 GetSourceTagBit(const FGameplayTag& Tag) const { const uint64* Bit = SourceTagBits.Find(Tag); return Bit ? *Bit : 0; }
+	uint64 GetTargetTagBit(const FGameplayTag& Tag) const { const uint64* Bit = TargetTagBits.Find(Tag); return Bit ? *Bit : 0; }
+
+	// Builds masks by querying the ASC for every reactive tag. Used when a mask is not being tracked.
+	uint64 ComputeSourceMask(const UAbilitySystemComponent& ASC) const;
+	uint64 ComputeTargetMask(const UAbilitySystemComponent& ASC) const;
+
+	// False when there are more than 64 distinct source or target tags; masks are then meaningless
+	bool SupportsMasks() const { return bSupportsMasks; }
+
+	// Cheap pre-filter. Returns false only if no rule can possibly match the two masks.
+	bool CanReact(uint64 SourceMask, uint64 TargetMask) const;
+
+	// Unique per build, so cached masks can tell they belong to an older index
+	uint32 GetGeneration() const { return Generation; }
+
+	const FElementalReactionRule& GetRule(int32 RuleIndex) const { return Rules[RuleIndex]; }
+	int32 NumRules() const { return Rules.Num(); }
+	bool IsEmpty() const { return SourceBuckets.Num() == 0; }
+
+private:
+	template<typename TargetPredicateType>
+	void FindMatchingRulesInternal(const FGameplayTagContainer& SourceTags, TargetPredicateType&& HasTargetTag, FRuleIndexArray& OutRuleIndices) const;
+
+	// Bits of the condition tags in ConditionTags, over the condition bit space of one side
+	struct FCompiledCondition
+	{
+		uint64 RequireAll = 0;
+		uint64 RequireAny = 0;
+		uint64 RequireNone = 0;
+
+		bool IsEmpty() const { return (RequireAll | RequireAny | RequireNone) == 0; }
+		bool Passes(uint64 OwnedBits) const
+		{
+			return (OwnedBits & RequireAll) == RequireAll && (RequireAny == 0 || (OwnedBits & RequireAny) != 0) && (OwnedBits & RequireNone) == 0;
+		}
+	};
+
+	struct FCompiledRule
+	{
+		FCompiledCondition Source;
+		FCompiledCondition Target;
+		int32 Priority = 0;
+		int32 ExclusivityGroup = INDEX_NONE;
+	};
+
+	// Evaluates every condition tag of one side once. Bit N is set if ConditionTags[N] is owned.
+	template<typename PredicateType>
+	static uint64 ComputeConditionBits(TConstArrayView<FGameplayTag> ConditionTags, PredicateType&& HasTag);
+
+	// Slow path when a side uses more than 64 condition tags
+	template<typename PredicateType>
+	static bool PassesCondition(const FEAReactionTagCondition& Condition, PredicateType&& HasTag);
+
+	// Assigns condition bits and exclusivity groups. Runs after the buckets are built.
+	void CompileConditions();
+
+	struct FTargetBucket
+	{
+		FGameplayTag TargetTag;
+		TArray<int32, TInlineAllocator<2>> RuleIndices;
+	};
+
+	struct FSourceBucket
+	{
+		FGameplayTag SourceTag;
+		TArray<FTargetBucket, TInlineAllocator<2>> Targets;
+	};
+
+	// Build helpers. BucketIndexBySourceTag only lives for the duration of Build.
+	int32 FindOrAddSourceBucket(const FGameplayTag& SourceTag, const FBuildInput& Input, TMap<FGameplayTag, int32>& BucketIndexBySourceTag);
+	static FTargetBucket& FindOrAddTargetBucket(FSourceBucket& Bucket, const FGameplayTag& TargetTag);
+	bool AddRuleToTarget(FTargetBucket& Target, int32 RuleIndex) const;
+
+	// Copy of the rules this index was compiled from
+	TArray<FElementalReactionRule> Rules;
+
+	// One bucket per distinct rule SourceTag
+	TArray<FSourceBucket> SourceBuckets;
+
+	// Owned tag (rule tag or any of its children) -> buckets it satisfies
+	TMap<FGameplayTag, TArray<int32, TInlineAllocator<1>>> SourceBucketsByTag;
+
+	// Rule tag -> its bit in the source/target mask space
+	TMap<FGameplayTag, uint64> SourceTagBits;
+	TMap<FGameplayTag, uint64> TargetTagBits;
+
+	// Per source bucket (same order as SourceBuckets): the target bits it can react with
+	TArray<uint64> CompatibleTargetMasks;
+
+	// Per rule (same order as Rules): condition masks, priority and exclusivity group index
+	TArray<FCompiledRule> CompiledRules;
+
+	// Condition tag at each bit of the source/target condition space
+	TArray<FGameplayTag> SourceConditionTags;
+	TArray<FGameplayTag> TargetConditionTags;
+
+	int32 NumExclusivityGroups = 0;
+
+	// False when either side uses more than 64 condition tags; conditions are then evaluated from the rules
+	bool bCompiledConditions = true;
+
+	// True if any rule has a priority, condition or exclusivity group; otherwise matching skips the resolve step
+	bool bNeedsResolve = false;
+
+	bool bSupportsMasks = true;
+	uint32 Generation = 0;
+};
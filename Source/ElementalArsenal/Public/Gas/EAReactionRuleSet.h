@@ -0,0 +1,67 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Gas/EAReactionTypes.h"
+#include "EAReactionRuleSet.generated.h"
+
+/** Rules of a set sharing the same source and target tag. Built when the set is saved. */
+USTRUCT()
+struct FEAReactionRuleBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag SourceTag;
+
+	UPROPERTY()
+	FGameplayTag TargetTag;
+
+	// Indices into the owning set's Rules
+	UPROPERTY()
+	TArray<int32> RuleIndices;
+};
+
+/**
+ * A group of reaction rules that can ship with a game feature or a map.
+ * Registered sets (see UEAReactionSubsystem::RegisterRuleSet and UEAReactionSettings::DefaultRuleSets)
+ * are merged with the project settings rules into one reaction index.
+ * Rules are grouped by source/target tag when the asset is saved, so merging a set costs one lookup per group.
+ */
+UCLASS(BlueprintType, Const)
+class ELEMENTALARSENAL_API UEAReactionRuleSet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Reactions", meta = (TitleProperty = "ReactionEffect"))
+	TArray<FElementalReactionRule> Rules;
+
+	// The saved grouping of Rules. Empty if it is out of date (checked in the editor only), in which case the index
+	// groups the rules itself.
+	TConstArrayView<FEAReactionRuleBucket> GetCompiledBuckets() const;
+
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+
+	// Invalid and duplicate (same tags and effect) rules are errors. The same tag pair with different effects is a warning.
+	static void ValidateRules(TConstArrayView<FElementalReactionRule> InRules, TArray<FText>& OutErrors, TArray<FText>& OutWarnings);
+#endif
+
+private:
+	void CompileBuckets();
+
+	// Hash of every rule's source/target tag and validity, i.e. everything the grouping depends on
+	uint32 ComputeBucketKey() const;
+
+	UPROPERTY()
+	TArray<FEAReactionRuleBucket> CompiledBuckets;
+
+	// ComputeBucketKey() when CompiledBuckets was built
+	UPROPERTY()
+	uint32 CompiledBucketKey = 0;
+};
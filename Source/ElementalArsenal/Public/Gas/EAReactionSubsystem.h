@@ -0,0 +1,92 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "Gas/EAReactionIndex.h"
+#include "EAReactionSubsystem.generated.h"
+
+class UEAReactionRuleSet;
+
+/**
+ * Owns the compiled reaction index.
+ * The index merges the project settings rules, the default rule sets and any registered rule sets.
+ * It is built once when the engine starts and rebuilt whenever one of those (or, in the editor,
+ * the gameplay tag tree) changes.
+ *
+ * ReloadReactionRules (console: ea.Reactions.Reload) re-reads the Game config from disk and rebuilds the index
+ * on a worker thread. The finished index replaces the old one on the game thread, so a hit always sees
+ * either the old or the new index in full. Non-shipping builds also poll DefaultGame.ini and reload when it changes.
+ */
+UCLASS()
+class ELEMENTALARSENAL_API UEAReactionSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Returns the subsystem, or nullptr if the engine is not up yet
+	static UEAReactionSubsystem* Get();
+
+	// The index currently in use. Valid for as long as the caller holds the reference.
+	TSharedRef<const FEAReactionIndex, ESPMode::ThreadSafe> GetReactionIndex() const { return ReactionIndex.ToSharedRef(); }
+
+	// Recompiles the index from the current project settings and rule sets
+	void RebuildReactionIndex();
+
+	// Re-reads the reaction settings from the config files, then rebuilds the index off the game thread
+	void ReloadReactionRules();
+
+	// Merges a rule set into the index (e.g. when a game feature or map loads). Registrations are counted,
+	// so every call must be balanced by UnregisterRuleSet.
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Reactions")
+	void RegisterRuleSet(const UEAReactionRuleSet* RuleSet);
+
+	UFUNCTION(BlueprintCallable, Category = "Elemental Arsenal|Reactions")
+	void UnregisterRuleSet(const UEAReactionRuleSet* RuleSet);
+
+private:
+	// Loads UEAReactionSettings::DefaultRuleSets
+	void LoadDefaultRuleSets();
+
+	// Snapshots the rules, compiles them on a worker thread and swaps the result in on the game thread
+	void RebuildReactionIndexAsync();
+
+#if !UE_BUILD_SHIPPING
+	// Reloads the rules when DefaultGame.ini changed on disk (ea.Reactions.WatchConfig)
+	bool PollConfigFile(float DeltaTime);
+
+	FTSTicker::FDelegateHandle ConfigPollHandle;
+	FDateTime ConfigTimestamp;
+#endif
+
+#if WITH_EDITOR
+	void HandleSettingsChanged(UObject* Settings, struct FPropertyChangedEvent& PropertyChangedEvent);
+	void HandleTagTreeChanged();
+	void HandleObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+
+	FDelegateHandle SettingsChangedHandle;
+	FDelegateHandle TagTreeChangedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+
+	UPROPERTY()
+	TArray<TObjectPtr<const UEAReactionRuleSet>> DefaultRuleSets;
+
+	// One entry per registration
+	UPROPERTY()
+	TArray<TObjectPtr<const UEAReactionRuleSet>> RegisteredRuleSets;
+
+	// Latest async build. Builds are chained, so this completes after all earlier ones.
+	UE::Tasks::FTask PendingBuild;
+
+	// Bumped by every rebuild. An async result is only swapped in if no rebuild started after it.
+	uint32 BuildSerial = 0;
+
+	TSharedPtr<const FEAReactionIndex, ESPMode::ThreadSafe> ReactionIndex;
+};
@@ -7,6 +7,36 @@
 #include "GameplayEffect.h"
 #include "EAReactionTypes.generated.h"
 
+/**
+ * Extra tags one side of a reaction must (not) own. Owning a child tag satisfies its parent.
+ */
+USTRUCT(BlueprintType)
+struct FEAReactionTagCondition
+{
+	GENERATED_BODY()
+
+	// Every one of these tags must be owned
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction")
+	FGameplayTagContainer RequireAll;
+
+	// At least one of these tags must be owned. Ignored when empty.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction")
+	FGameplayTagContainer RequireAny;
+
+	// None of these tags may be owned
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction")
+	FGameplayTagContainer RequireNone;
+
+	bool IsEmpty() const { return RequireAll.IsEmpty() && RequireAny.IsEmpty() && RequireNone.IsEmpty(); }
+
+	bool operator==(const FEAReactionTagCondition& Other) const
+	{
+		return RequireAll == Other.RequireAll && RequireAny == Other.RequireAny && RequireNone == Other.RequireNone;
+	}
+
+	bool operator!=(const FEAReactionTagCondition& Other) const { return !(*this == Other); }
+};
+
 /**
  * Defines a single elemental reaction rule.
  * Example: If Source has "Element.Fire" and Target has "Status.Oil", apply "GE_Explosion".
@@ -28,4 +58,44 @@ struct FElementalReactionRule
 	// This GE should ideally have a GameplayCue attached to it for the VFX!
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction")
 	TSubclassOf<UGameplayEffect> ReactionEffect;
+
+	// Minimum time in seconds before this rule can trigger again on the same target. 0 = no cooldown.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction", meta = (ClampMin = "0.0", Units = "s"))
+	float InternalCooldown = 0.f;
+
+	// Additional tags the attacker must (not) own
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction|Conditions")
+	FEAReactionTagCondition SourceConditions;
+
+	// Additional tags the victim must (not) own
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction|Conditions")
+	FEAReactionTagCondition TargetConditions;
+
+	// Rules sharing an exclusivity group compete: only the highest priority match in the group fires per hit.
+	// Rules without a group always fire.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction|Priority")
+	FName ExclusivityGroup;
+
+	// Higher fires first and wins its exclusivity group. Ties go to the rule listed first.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction|Priority")
+	int32 Priority = 0;
+
+	// Radius around the target in which the reaction spreads to others owning TargetTag (e.g. an explosion
+	// igniting nearby oiled targets). Spreading runs breadth first over several frames. 0 = no spreading.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction|Propagation", meta = (ClampMin = "0.0", Units = "cm"))
+	float PropagationRadius = 0.f;
+
+	// How many hops the reaction can spread from the original target
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reaction|Propagation", meta = (ClampMin = "1", EditCondition = "PropagationRadius > 0"))
+	int32 MaxPropagationDepth = 1;
+
+	// Rules missing a tag or the effect never match
+	bool IsValid() const { return SourceTag.IsValid() && TargetTag.IsValid() && ReactionEffect != nullptr; }
+
+	// Same trigger and same outcome, so applying both would double the reaction
+	bool IsDuplicateOf(const FElementalReactionRule& Other) const
+	{
+		return SourceTag == Other.SourceTag && TargetTag == Other.TargetTag && ReactionEffect == Other.ReactionEffect
+			&& SourceConditions == Other.SourceConditions && TargetConditions == Other.TargetConditions && ExclusivityGroup == Other.ExclusivityGroup;
+	}
 };
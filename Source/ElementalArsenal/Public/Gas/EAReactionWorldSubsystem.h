@@ -0,0 +1,261 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "UObject/ObjectKey.h"
+#include "Gas/EAReactionIndex.h"
+#include "GameplayEffectTypes.h"
+#include "EAReactionWorldSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayEffect;
+class UEAReactionWorldSubsystem;
+
+/** One source/target pair to match against the reaction rules. */
+struct FEAReactionMatchRequest
+{
+	UAbilitySystemComponent* SourceASC = nullptr;
+	UAbilitySystemComponent* TargetASC = nullptr;
+
+	// Class of the effect that caused the hit. Rules reacting with this same effect are skipped.
+	const UClass* SourceEffectClass = nullptr;
+};
+
+/** A rule matched for a request, by index into the request batch and the reaction index. */
+struct FEAReactionMatch
+{
+	int32 RequestIndex = INDEX_NONE;
+	int32 RuleIndex = INDEX_NONE;
+};
+
+/**
+ * While in scope, reactions triggered in the given world are collected instead of being matched one by one.
+ * On destruction the whole batch is matched in parallel and applied on the game thread.
+ * Wrap AoE damage loops with this; the deferred flush and spreading reactions open one around their own loops.
+ */
+struct ELEMENTALARSENAL_API FEAScopedReactionBatch
+{
+	explicit FEAScopedReactionBatch(const UWorld* World);
+	~FEAScopedReactionBatch();
+
+private:
+	UEAReactionWorldSubsystem* ReactionWorld;
+};
+
+/** Flushes the deferred reaction queue and advances spreading reactions at the configured tick group. */
+USTRUCT()
+struct FEAReactionQueueTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UEAReactionWorldSubsystem* Owner = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FEAReactionQueueTickFunction> : public TStructOpsTypeTraitsBase2<FEAReactionQueueTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Per-world entry point for applying matched reactions.
+ * Applies them immediately, or, when deferred reactions are enabled in the settings,
+ * queues them and resolves the whole batch once per frame.
+ *
+ * Reactions with a PropagationRadius spread breadth first to nearby targets that can react with the same rule.
+ * Each chain tracks the targets it has visited and stops at the rule's MaxPropagationDepth; the scheduler applies
+ * as many hops per frame as the propagation budget allows, so large chains play out over several frames.
+ */
+UCLASS()
+class ELEMENTALARSENAL_API UEAReactionWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Applies or queues a reaction matched by the given index. False if it was suppressed by a cooldown or the frame
+	// budget; a queued reaction counts as submitted even though the flush can still drop it.
+	bool SubmitReaction(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex);
+
+	// Applies the rule's reaction effect right away, reusing a cached spec when possible, and starts spreading it
+	// if the rule has a PropagationRadius. Returns false if the reaction was suppressed by a cooldown or the frame budget.
+	bool ApplyReaction(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex);
+
+	// Applies the rule's reaction effect right away. Used directly when no world subsystem exists.
+	static void ApplyReactionEffect(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FElementalReactionRule& Rule);
+
+	// Records an applied reaction in FEACombatEventStream, if anyone is listening
+	static void PublishReactionEvent(const UAbilitySystemComponent& SourceASC, const UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex);
+
+	// Builds the outgoing spec for a reaction, tagged with Effect.Reaction
+	static FGameplayEffectSpecHandle MakeReactionSpec(UAbilitySystemComponent& SourceASC, const FElementalReactionRule& Rule, float Level);
+
+	// Matches all requests against the index. Read-only on the ASCs; large batches run with ParallelFor.
+	// Must be called from the game thread so no tag can change while workers read them.
+	static void MatchReactions(TConstArrayView<FEAReactionMatchRequest> Requests, const FEAReactionIndex& Index, TArray<FEAReactionMatch>& OutMatches);
+
+	// Matches and then applies (or queues) a batch of requests on the game thread
+	void ProcessReactionBatch(TConstArrayView<FEAReactionMatchRequest> Requests);
+
+	// True while an FEAScopedReactionBatch is open for this world
+	bool IsBatchingReactions() const { return BatchScopeDepth > 0; }
+
+	// Adds a request to the open batch
+	void AddBatchedReaction(const FEAReactionMatchRequest& Request) { BatchedRequests.Add(Request); }
+
+	// Resolves queued reactions. Called by the tick function.
+	void FlushDeferredReactions();
+
+	int32 GetNumPendingReactions() const { return PendingReactions.Num(); }
+
+	// Applies queued spreading reactions, oldest hop first, within the propagation budget. Called by the tick function.
+	void ProcessPropagationQueue();
+
+	int32 GetNumQueuedPropagations() const { return PropagationQueue.Num() - PropagationQueueHead; }
+
+	// Reactions applied by this world since it started. Cheap enough to leave on in Shipping.
+	uint64 GetNumReactionsApplied() const { return NumReactionsApplied; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPendingReaction
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+		TWeakObjectPtr<UAbilitySystemComponent> TargetASC;
+		int32 RuleIndex = INDEX_NONE;
+	};
+
+	friend struct FEAScopedReactionBatch;
+
+	int32 BatchScopeDepth = 0;
+	TArray<FEAReactionMatchRequest> BatchedRequests;
+
+	// Target + rule, used to merge duplicates within a frame
+	using FPendingReactionKey = TPair<FObjectKey, int32>;
+
+	TArray<FPendingReaction> PendingReactions;
+	TSet<FPendingReactionKey> PendingReactionKeys;
+
+	// Generation of the index the pending rule indices refer to
+	uint32 PendingIndexGeneration = 0;
+
+	// Enables the tick function while reactions are queued or spreading
+	void UpdateQueueTickEnabled();
+
+	// ApplyReaction without spreading
+	bool TryApplyReaction(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex);
+
+	struct FPropagationNode
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+		TWeakObjectPtr<UAbilitySystemComponent> TargetASC;
+		int32 RuleIndex = INDEX_NONE;
+		int32 Depth = 0;
+		uint32 ChainId = 0;
+	};
+
+	struct FPropagationChain
+	{
+		// Targets already reached, including the one the chain started on
+		TSet<FObjectKey> Visited;
+		int32 NumQueued = 0;
+	};
+
+	void StartPropagationChain(UAbilitySystemComponent& SourceASC, UAbilitySystemComponent& OriginASC, const FEAReactionIndex& Index, int32 RuleIndex);
+
+	// Queues every unvisited target around OriginASC that can react with the rule
+	void ExpandPropagation(UAbilitySystemComponent& SourceASC, const UAbilitySystemComponent& OriginASC, const FEAReactionIndex& Index, int32 RuleIndex, uint32 ChainId, int32 Depth);
+
+	// ASCs whose avatars overlap a sphere covering every point within Radius of the grid cell around Origin.
+	// Cached for the frame; callers still check the exact distance.
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& QueryPropagationCandidates(const FVector& Origin, float Radius);
+
+	void ResetPropagation();
+
+	// FIFO of hops; consumed from PropagationQueueHead and compacted once mostly consumed
+	TArray<FPropagationNode> PropagationQueue;
+	int32 PropagationQueueHead = 0;
+
+	TMap<uint32, FPropagationChain> PropagationChains;
+	uint32 NextPropagationChainId = 1;
+
+	// Generation of the index the queued rule indices refer to
+	uint32 PropagationIndexGeneration = 0;
+
+	// Grid cell + radius
+	using FPropagationQueryKey = TPair<FIntVector, int32>;
+
+	TMap<FPropagationQueryKey, TArray<TWeakObjectPtr<UAbilitySystemComponent>>> PropagationQueryCache;
+	uint64 PropagationQueryCacheFrame = 0;
+
+	// Returns a spec for the source/rule/level, building and caching it on a miss
+	FGameplayEffectSpecHandle GetOrMakeReactionSpec(UAbilitySystemComponent& SourceASC, const FEAReactionIndex& Index, int32 RuleIndex, float Level);
+	void ResetSpecCache();
+
+	// Drops the source's cached specs. The entry and its tag event stay registered.
+	void InvalidateSpecCache(FObjectKey SourceKey);
+
+	// Removes entries of destroyed or idle sources, unregistering their tag events
+	void PruneSpecCache(double Now);
+
+	struct FCachedSpec
+	{
+		int32 RuleIndex = INDEX_NONE;
+		float Level = 0.f;
+		FGameplayEffectSpecHandle SpecHandle;
+	};
+
+	struct FSourceSpecCache
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+		FDelegateHandle TagEventHandle;
+		TArray<FCachedSpec, TInlineAllocator<2>> Specs;
+
+		// Frame the specs were built in, and world time of the last lookup
+		uint64 SpecsFrame = 0;
+		double LastUsedTime = 0.0;
+	};
+
+	// Entries live as long as the source keeps reacting; only their specs are dropped every frame
+	TMap<FObjectKey, FSourceSpecCache> SpecCache;
+	uint32 SpecCacheIndexGeneration = 0;
+	double LastSpecCachePruneTime = 0.0;
+
+	// True if the frame budget still has room for another reaction
+	bool HasReactionBudget();
+
+	// Checks the target and rule cooldowns and, if they pass, records the reaction and consumes budget
+	bool TryConsumeReactionLimits(const UAbilitySystemComponent& TargetASC, const FEAReactionIndex& Index, int32 RuleIndex);
+	void PruneReactionTimes(double Now);
+
+	// Last reaction times per target. Rule entries are few, so they are kept inline.
+	struct FTargetReactionTimes
+	{
+		double LastReactionTime = -UE_BIG_NUMBER;
+		TArray<TPair<int32, double>, TInlineAllocator<2>> LastRuleTimes;
+	};
+
+	TMap<FObjectKey, FTargetReactionTimes> ReactionTimes;
+	uint32 ReactionTimesIndexGeneration = 0;
+	double LastReactionTimesPruneTime = 0.0;
+
+	uint64 ReactionBudgetFrame = 0;
+	int32 ReactionsThisFrame = 0;
+
+	uint64 NumReactionsApplied = 0;
+
+	FEAReactionQueueTickFunction QueueTickFunction;
+};
@@ -48,6 +48,8 @@ public class ElementalArsenalEditor : ModuleRules
 				"GameplayAbilities",
 				"GameplayTags",
 				"GameplayTasks",
+				"Json",
+				"Projects",
 				"ElementalArsenal"
 			}
 			);
@@ -0,0 +1,466 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Commandlets/EABenchmarkCommandlet.h"
+#include "EAGameplayTags.h"
+#include "EAReactionSettings.h"
+#include "Gas/EAAttributeSet.h"
+#include "Gas/EAReactionSubsystem.h"
+#include "Gas/EAReactionWorldSubsystem.h"
+#include "Equipment/EAEquipmentComponent.h"
+#include "Equipment/EAEquipmentDefinition.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayTagsManager.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEABenchmark, Log, All);
+
+namespace EABenchmark
+{
+	// Forwards to the real allocator and counts the allocations of threads inside an FScopedAllocationCounter.
+	// Counts are thread local, so worker threads allocating meanwhile neither race with nor skew the measurement.
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return Inner->Malloc(Count, Alignment); }
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return Inner->TryMalloc(Count, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { if (Count > 0) { CountAllocation(); } return Inner->Realloc(Original, Count, Alignment); }
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { if (Count > 0) { CountAllocation(); } return Inner->TryRealloc(Original, Count, Alignment); }
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+		static inline thread_local bool bCounting = false;
+		static inline thread_local uint64 NumAllocations = 0;
+
+	private:
+		static void CountAllocation()
+		{
+			if (bCounting)
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	// Installs the counting proxy as GMalloc, once per process. It is never removed: a thread that read the previous
+	// GMalloc keeps a valid allocator, and both end up in the same heap, so frees may go through either one.
+	static void InstallCountingMalloc()
+	{
+		static bool bInstalled = false;
+		if (!bInstalled)
+		{
+			bInstalled = true;
+			FMalloc* Proxy = new FCountingMalloc(GMalloc);
+			FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), Proxy);
+		}
+	}
+
+	// Counts the allocations made by the current thread while in scope. Requires InstallCountingMalloc.
+	struct FScopedAllocationCounter
+	{
+		FScopedAllocationCounter() : StartCount(FCountingMalloc::NumAllocations) { FCountingMalloc::bCounting = true; }
+		~FScopedAllocationCounter() { FCountingMalloc::bCounting = false; }
+
+		uint64 GetCount() const { return FCountingMalloc::NumAllocations - StartCount; }
+
+	private:
+		uint64 StartCount;
+	};
+
+	struct FHitResults
+	{
+		double NsPerHit = 0.0;
+		double AllocsPerHit = 0.0;
+		uint64 Reactions = 0;
+		double ReactionsPerSecond = 0.0;
+	};
+
+	struct FEquipResults
+	{
+		double NsPerEquip = 0.0;
+		double NsPerUnequip = 0.0;
+		double NsPerSwap = 0.0;
+	};
+
+	static constexpr float FrameDeltaSeconds = 1.f / 60.f;
+
+	// Registered tags, minus the plugin's own, split in half into source and target tags
+	static bool CollectTags(TArray<FGameplayTag>& OutSourceTags, TArray<FGameplayTag>& OutTargetTags)
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, true);
+
+		FGameplayTagContainer ExcludedTags;
+		ExcludedTags.AddTag(FEAGameplayTags::Get().Effect_Reaction);
+		ExcludedTags.AddTag(FEAGameplayTags::Get().Equipment_Slot_MainHand.RequestDirectParent());
+
+		TArray<FGameplayTag> Tags;
+		for (const FGameplayTag& Tag : AllTags)
+		{
+			if (!Tag.MatchesAny(ExcludedTags))
+			{
+				Tags.Add(Tag);
+			}
+		}
+
+		if (Tags.Num() < 2)
+		{
+			return false;
+		}
+
+		// Stable across runs, so results stay comparable
+		Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetTagName().LexicalLess(B.GetTagName()); });
+
+		const int32 NumSourceTags = Tags.Num() / 2;
+		OutSourceTags.Append(Tags.GetData(), NumSourceTags);
+		OutTargetTags.Append(Tags.GetData() + NumSourceTags, Tags.Num() - NumSourceTags);
+		return true;
+	}
+
+	static TArray<FElementalReactionRule> BuildRules(int32 NumRules, const TArray<FGameplayTag>& SourceTags, const TArray<FGameplayTag>& TargetTags)
+	{
+		TArray<FElementalReactionRule> Rules;
+		Rules.Reserve(NumRules);
+
+		for (int32 RuleIndex = 0; RuleIndex < NumRules; ++RuleIndex)
+		{
+			FElementalReactionRule& Rule = Rules.AddDefaulted_GetRef();
+			Rule.SourceTag = SourceTags[RuleIndex % SourceTags.Num()];
+			Rule.TargetTag = TargetTags[(RuleIndex / SourceTags.Num()) % TargetTags.Num()];
+			Rule.ReactionEffect = UEABenchmarkReactionEffect::StaticClass();
+		}
+		return Rules;
+	}
+
+	static UWorld* CreateBenchmarkWorld()
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("EABenchmarkWorld"));
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	static void DestroyBenchmarkWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	static void AdvanceFrame(UWorld* World)
+	{
+		// Frame budgets, spec caches and cooldowns are all keyed on the frame counter or world time
+		++GFrameCounter;
+		World->Tick(LEVELTICK_All, FrameDeltaSeconds);
+	}
+
+	static void SpawnBenchmarkActor(UWorld* World, const FGameplayTag& SourceTag, const FGameplayTag& TargetTag, TArray<UAbilitySystemComponent*>& OutASCs, TArray<UEAEquipmentComponent*>& OutEquipmentComponents)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		// Equipment visuals need something to attach to
+		USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+		Actor->SetRootComponent(Root);
+		Root->RegisterComponent();
+
+		UAbilitySystemComponent* ASC = NewObject<UAbilitySystemComponent>(Actor, TEXT("AbilitySystem"));
+		ASC->RegisterComponent();
+		ASC->InitAbilityActorInfo(Actor, Actor);
+		ASC->InitStats(UEAAttributeSet::StaticClass(), nullptr);
+		ASC->SetNumericAttributeBase(UEAAttributeSet::GetMaxHealthAttribute(), 1.e9f);
+		ASC->SetNumericAttributeBase(UEAAttributeSet::GetHealthAttribute(), 1.e9f);
+		ASC->AddLooseGameplayTag(SourceTag);
+		ASC->AddLooseGameplayTag(TargetTag);
+
+		UEAEquipmentComponent* Equipment = NewObject<UEAEquipmentComponent>(Actor, TEXT("Equipment"));
+		Equipment->RegisterComponent();
+
+		OutASCs.Add(ASC);
+		OutEquipmentComponents.Add(Equipment);
+	}
+
+	// Each hit builds and applies a damage spec from one ASC to another, as an ability would.
+	// Frame ticks (and with them any deferred reaction flush) are part of the measurement.
+	static FHitResults RunHits(UWorld* World, const TArray<UAbilitySystemComponent*>& ASCs, int32 NumHits, int32 HitsPerFrame)
+	{
+		const int64 NumASCs = ASCs.Num();
+		auto ApplyHit = [&ASCs, NumASCs](int64 Hit)
+		{
+			UAbilitySystemComponent* SourceASC = ASCs[Hit % NumASCs];
+			UAbilitySystemComponent* TargetASC = ASCs[(Hit * 7 + 1) % NumASCs];
+
+			const FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(UEABenchmarkDamageEffect::StaticClass(), 1.f, SourceASC->MakeEffectContext());
+			SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
+		};
+
+		// Warm up caches, pools and the reactive tag masks
+		for (int64 Hit = 0; Hit < HitsPerFrame; ++Hit)
+		{
+			ApplyHit(Hit);
+		}
+		AdvanceFrame(World);
+
+		const UEAReactionWorldSubsystem* ReactionWorld = World->GetSubsystem<UEAReactionWorldSubsystem>();
+		const uint64 ReactionsBefore = ReactionWorld ? ReactionWorld->GetNumReactionsApplied() : 0;
+
+		uint64 NumAllocations = 0;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		{
+			FScopedAllocationCounter AllocationCounter;
+			for (int64 Hit = 0; Hit < NumHits; ++Hit)
+			{
+				ApplyHit(Hit);
+				if ((Hit + 1) % HitsPerFrame == 0)
+				{
+					AdvanceFrame(World);
+				}
+			}
+			NumAllocations = AllocationCounter.GetCount();
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		FHitResults Results;
+		Results.NsPerHit = Seconds * 1.e9 / NumHits;
+		Results.AllocsPerHit = static_cast<double>(NumAllocations) / NumHits;
+		Results.Reactions = ReactionWorld ? ReactionWorld->GetNumReactionsApplied() - ReactionsBefore : 0;
+		Results.ReactionsPerSecond = Seconds > 0.0 ? Results.Reactions / Seconds : 0.0;
+		return Results;
+	}
+
+	static FEquipResults RunEquips(UWorld* World, const TArray<UEAEquipmentComponent*>& Components, const TArray<UEAEquipmentDefinition*>& Definitions, int32 NumEquips)
+	{
+		const int32 NumComponents = Components.Num();
+		const int32 NumDefinitions = Definitions.Num();
+
+		// Equip into an empty slot, then clear it
+		uint64 EquipCycles = 0;
+		uint64 UnequipCycles = 0;
+		for (int32 EquipIndex = 0; EquipIndex < NumEquips; ++EquipIndex)
+		{
+			UEAEquipmentComponent* Component = Components[EquipIndex % NumComponents];
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Component->EquipItem(Definitions[EquipIndex % NumDefinitions]);
+			const uint64 EquippedCycles = FPlatformTime::Cycles64();
+			Component->UnequipItem();
+
+			EquipCycles += EquippedCycles - StartCycles;
+			UnequipCycles += FPlatformTime::Cycles64() - EquippedCycles;
+		}
+
+		// Swap one item for another in an occupied slot (the diffing path)
+		for (UEAEquipmentComponent* Component : Components)
+		{
+			Component->EquipItem(Definitions[0]);
+		}
+
+		const uint64 SwapStartCycles = FPlatformTime::Cycles64();
+		for (int32 EquipIndex = 0; EquipIndex < NumEquips; ++EquipIndex)
+		{
+			Components[EquipIndex % NumComponents]->EquipItem(Definitions[(EquipIndex / NumComponents + 1) % NumDefinitions]);
+		}
+		const uint64 SwapCycles = FPlatformTime::Cycles64() - SwapStartCycles;
+
+		for (UEAEquipmentComponent* Component : Components)
+		{
+			Component->UnequipItem();
+		}
+		AdvanceFrame(World);
+
+		FEquipResults Results;
+		Results.NsPerEquip = FPlatformTime::ToSeconds64(EquipCycles) * 1.e9 / NumEquips;
+		Results.NsPerUnequip = FPlatformTime::ToSeconds64(UnequipCycles) * 1.e9 / NumEquips;
+		Results.NsPerSwap = FPlatformTime::ToSeconds64(SwapCycles) * 1.e9 / NumEquips;
+		return Results;
+	}
+}
+
+UEABenchmarkDamageEffect::UEABenchmarkDamageEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FGameplayModifierInfo DamageModifier;
+	DamageModifier.Attribute = UEAAttributeSet::GetIncomingDamageAttribute();
+	DamageModifier.ModifierOp = EGameplayModOp::Additive;
+	DamageModifier.ModifierMagnitude = FScalableFloat(1.f);
+	Modifiers.Add(DamageModifier);
+}
+
+UEABenchmarkCommandlet::UEABenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UEABenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumASCs = 1000;
+	int32 NumRules = 32;
+	int32 NumHits = 100000;
+	int32 HitsPerFrame = 1000;
+	int32 NumEquips = 10000;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("ElementalArsenal.json");
+
+	FParse::Value(*Params, TEXT("ASCs="), NumASCs);
+	FParse::Value(*Params, TEXT("Rules="), NumRules);
+	FParse::Value(*Params, TEXT("Hits="), NumHits);
+	FParse::Value(*Params, TEXT("HitsPerFrame="), HitsPerFrame);
+	FParse::Value(*Params, TEXT("Equips="), NumEquips);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	NumASCs = FMath::Max(NumASCs, 2);
+	NumRules = FMath::Max(NumRules, 1);
+	NumHits = FMath::Max(NumHits, 1);
+	HitsPerFrame = FMath::Max(HitsPerFrame, 1);
+	NumEquips = FMath::Max(NumEquips, 1);
+
+	UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+	if (!ReactionSubsystem)
+	{
+		UE_LOG(LogEABenchmark, Error, TEXT("EABenchmark: Reaction subsystem is not available."));
+		return 1;
+	}
+
+	// 1. Tags for the synthetic rules
+	TArray<FGameplayTag> SourceTags;
+	TArray<FGameplayTag> TargetTags;
+	if (!EABenchmark::CollectTags(SourceTags, TargetTags))
+	{
+		UE_LOG(LogEABenchmark, Error, TEXT("EABenchmark: Needs at least two gameplay tags registered in the project."));
+		return 1;
+	}
+
+	EABenchmark::InstallCountingMalloc();
+
+	// Restore the project's rules however the run ends
+	UEAReactionSettings* Settings = GetMutableDefault<UEAReactionSettings>();
+	const TArray<FElementalReactionRule> SavedRules = Settings->ReactionRules;
+	ON_SCOPE_EXIT
+	{
+		Settings->ReactionRules = SavedRules;
+		ReactionSubsystem->RebuildReactionIndex();
+	};
+
+	// 2. World, actors and equipment
+	UWorld* World = EABenchmark::CreateBenchmarkWorld();
+
+	TArray<UAbilitySystemComponent*> ASCs;
+	TArray<UEAEquipmentComponent*> EquipmentComponents;
+	for (int32 ActorIndex = 0; ActorIndex < NumASCs; ++ActorIndex)
+	{
+		EABenchmark::SpawnBenchmarkActor(World, SourceTags[ActorIndex % SourceTags.Num()], TargetTags[ActorIndex % TargetTags.Num()], ASCs, EquipmentComponents);
+	}
+
+	TSoftObjectPtr<UStaticMesh> CubeMesh(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")));
+	CubeMesh.LoadSynchronous();
+
+	TArray<UEAEquipmentDefinition*> Definitions;
+	for (int32 DefinitionIndex = 0; DefinitionIndex < 4; ++DefinitionIndex)
+	{
+		UEAEquipmentDefinition* Definition = NewObject<UEAEquipmentDefinition>(GetTransientPackage(), *FString::Printf(TEXT("EABenchmarkItem_%d"), DefinitionIndex));
+		Definition->StaticMeshToSpawn = CubeMesh;
+		Definition->AbilitiesToGrant.Add(UGameplayAbility::StaticClass());
+		Definition->EquipmentTags.AddTag(SourceTags[DefinitionIndex % SourceTags.Num()]);
+		Definition->AddToRoot();
+		Definitions.Add(Definition);
+	}
+
+	// 3. Damage events without any rule, then with the synthetic rules
+	Settings->ReactionRules.Reset();
+	ReactionSubsystem->RebuildReactionIndex();
+	const EABenchmark::FHitResults Baseline = EABenchmark::RunHits(World, ASCs, NumHits, HitsPerFrame);
+
+	Settings->ReactionRules = EABenchmark::BuildRules(NumRules, SourceTags, TargetTags);
+	ReactionSubsystem->RebuildReactionIndex();
+	const EABenchmark::FHitResults WithRules = EABenchmark::RunHits(World, ASCs, NumHits, HitsPerFrame);
+
+	// 4. Equip / unequip throughput
+	const EABenchmark::FEquipResults Equip = EABenchmark::RunEquips(World, EquipmentComponents, Definitions, NumEquips);
+
+	// 5. Clean up. The rules are restored on scope exit.
+	for (UEAEquipmentDefinition* Definition : Definitions)
+	{
+		Definition->RemoveFromRoot();
+	}
+	EABenchmark::DestroyBenchmarkWorld(World);
+
+	// 6. Report
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("ElementalArsenal"));
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("plugin_version"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : TEXT("unknown"));
+	Root->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("build_configuration"), LexToString(FApp::GetBuildConfiguration()));
+
+	TSharedRef<FJsonObject> Config = MakeShared<FJsonObject>();
+	Config->SetNumberField(TEXT("ascs"), NumASCs);
+	Config->SetNumberField(TEXT("rules"), NumRules);
+	Config->SetNumberField(TEXT("hits"), NumHits);
+	Config->SetNumberField(TEXT("hits_per_frame"), HitsPerFrame);
+	Config->SetNumberField(TEXT("equips"), NumEquips);
+	Config->SetBoolField(TEXT("defer_reactions"), Settings->bDeferReactions);
+	Config->SetBoolField(TEXT("cache_reaction_specs"), Settings->bCacheReactionSpecs);
+	Root->SetObjectField(TEXT("config"), Config);
+
+	TSharedRef<FJsonObject> Reactions = MakeShared<FJsonObject>();
+	Reactions->SetNumberField(TEXT("baseline_ns_per_hit"), Baseline.NsPerHit);
+	Reactions->SetNumberField(TEXT("ns_per_hit"), WithRules.NsPerHit);
+	Reactions->SetNumberField(TEXT("reaction_overhead_ns_per_hit"), WithRules.NsPerHit - Baseline.NsPerHit);
+	Reactions->SetNumberField(TEXT("baseline_allocs_per_hit"), Baseline.AllocsPerHit);
+	Reactions->SetNumberField(TEXT("allocs_per_hit"), WithRules.AllocsPerHit);
+	Reactions->SetNumberField(TEXT("reactions"), static_cast<double>(WithRules.Reactions));
+	Reactions->SetNumberField(TEXT("reactions_per_second"), WithRules.ReactionsPerSecond);
+	Root->SetObjectField(TEXT("reactions"), Reactions);
+
+	TSharedRef<FJsonObject> Equipment = MakeShared<FJsonObject>();
+	Equipment->SetNumberField(TEXT("ns_per_equip"), Equip.NsPerEquip);
+	Equipment->SetNumberField(TEXT("ns_per_unequip"), Equip.NsPerUnequip);
+	Equipment->SetNumberField(TEXT("ns_per_swap"), Equip.NsPerSwap);
+	Equipment->SetNumberField(TEXT("equips_per_second"), Equip.NsPerEquip > 0.0 ? 1.e9 / Equip.NsPerEquip : 0.0);
+	Root->SetObjectField(TEXT("equipment"), Equipment);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	UE_LOG(LogEABenchmark, Display, TEXT("%s"), *Json);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogEABenchmark, Error, TEXT("EABenchmark: Could not write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogEABenchmark, Display, TEXT("EABenchmark: Results written to %s"), *OutputPath);
+	return 0;
+}
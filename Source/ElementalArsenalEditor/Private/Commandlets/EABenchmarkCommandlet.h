@@ -0,0 +1,45 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameplayEffect.h"
+#include "EABenchmarkCommandlet.generated.h"
+
+/**
+ * Headless performance benchmark for the reaction and equipment pipelines.
+ * Spawns N actors with an ASC, UEAAttributeSet and UEAEquipmentComponent in a transient game world,
+ * replaces the reaction rules with M synthetic ones built from the registered gameplay tags, and measures
+ * damage events, reactions and equip/unequip throughput. Results are written as JSON.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=EABenchmark -nullrhi -unattended
+ *     [-ASCs=1000] [-Rules=32] [-Hits=100000] [-HitsPerFrame=1000] [-Equips=10000] [-Output=<file.json>]
+ */
+UCLASS()
+class UEABenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEABenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
+
+/** Instant effect adding 1 to IncomingDamage. Stands in for an ability's damage effect. */
+UCLASS(HideDropdown)
+class UEABenchmarkDamageEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UEABenchmarkDamageEffect();
+};
+
+/** Instant effect without modifiers, used as the reaction effect of every synthetic rule */
+UCLASS(HideDropdown)
+class UEABenchmarkReactionEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+};
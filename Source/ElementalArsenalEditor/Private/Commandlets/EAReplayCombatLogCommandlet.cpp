@@ -0,0 +1,401 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#include "Commandlets/EAReplayCombatLogCommandlet.h"
+#include "EACombatLog.h"
+#include "EAReactionSettings.h"
+#include "Gas/EAReactionIndex.h"
+#include "Gas/EAReactionRuleSet.h"
+#include "Gas/EAReactionSubsystem.h"
+#include "GameplayTagsManager.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEAReplay, Log, All);
+
+namespace EAReplayCombatLog
+{
+	using FMatchArray = TArray<EACombatLog::FMatch, TInlineAllocator<4>>;
+
+	struct FDecision
+	{
+		uint64 Frame = 0;
+		FGameplayTagContainer SourceTags;
+		FGameplayTagContainer TargetTags;
+
+		// Sorted, so decisions compare element by element
+		FMatchArray RecordedMatches;
+
+		// Reactions applied or queued after the guards, cooldowns and budget. Not compared: they depend on runtime state.
+		int32 NumApplied = 0;
+		bool bAppliedKnown = true;
+	};
+
+	// Decodes the mapped log. False if it is not a combat log of this version or is truncated.
+	static bool DecodeLog(const uint8* Data, int64 Size, TArray<FName>& OutNames, TArray<FDecision>& OutDecisions)
+	{
+		using namespace EACombatLog;
+
+		int64 Offset = 0;
+		int64 End = Size;
+
+		// Records are packed, so nothing after the file header is guaranteed to be aligned
+		auto Read = [Data, &Offset, &End](auto& OutValue)
+		{
+			if (Offset + int64(sizeof(OutValue)) > End)
+			{
+				return false;
+			}
+			FMemory::Memcpy(&OutValue, Data + Offset, sizeof(OutValue));
+			Offset += sizeof(OutValue);
+			return true;
+		};
+
+		FFileHeader Header;
+		if (!Read(Header) || Header.Magic != Magic || Header.Version != Version || Header.NameTableOffset > uint64(Size))
+		{
+			return false;
+		}
+
+		// 1. Name table, and the tag of every name that is one
+		Offset = Header.NameTableOffset;
+		uint32 NumNames = 0;
+		if (!Read(NumNames))
+		{
+			return false;
+		}
+
+		OutNames.Reserve(NumNames);
+		for (uint32 NameIndex = 0; NameIndex < NumNames; ++NameIndex)
+		{
+			uint16 Length = 0;
+			if (!Read(Length) || Offset + Length > End)
+			{
+				return false;
+			}
+
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+			OutNames.Add(FName(FString(Converted.Length(), Converted.Get())));
+			Offset += Length;
+		}
+
+		TArray<FGameplayTag> Tags;
+		Tags.Reserve(OutNames.Num());
+		for (const FName Name : OutNames)
+		{
+			Tags.Add(FGameplayTag::RequestGameplayTag(Name, false));
+		}
+
+		auto AddTag = [&Tags](uint32 NameIndex, FGameplayTagContainer& Container)
+		{
+			// Tags removed from the project since the recording are skipped
+			if (Tags.IsValidIndex(NameIndex) && Tags[NameIndex].IsValid())
+			{
+				Container.AddTag(Tags[NameIndex]);
+			}
+		};
+
+		// 2. Records
+		Offset = sizeof(FFileHeader);
+		End = Header.NameTableOffset;
+		OutDecisions.Reserve(Header.NumRecords);
+
+		for (uint64 RecordIndex = 0; RecordIndex < Header.NumRecords; ++RecordIndex)
+		{
+			FRecordHeader Record;
+			if (!Read(Record))
+			{
+				return false;
+			}
+
+			FDecision& Decision = OutDecisions.AddDefaulted_GetRef();
+			Decision.Frame = Record.Frame;
+
+			uint32 NameIndex = NoName;
+			for (int32 TagIndex = 0; TagIndex < Record.NumSourceTags; ++TagIndex)
+			{
+				if (!Read(NameIndex))
+				{
+					return false;
+				}
+				AddTag(NameIndex, Decision.SourceTags);
+			}
+			for (int32 TagIndex = 0; TagIndex < Record.NumTargetTags; ++TagIndex)
+			{
+				if (!Read(NameIndex))
+				{
+					return false;
+				}
+				AddTag(NameIndex, Decision.TargetTags);
+			}
+
+			for (int32 MatchIndex = 0; MatchIndex < Record.NumMatches; ++MatchIndex)
+			{
+				FMatch& Match = Decision.RecordedMatches.AddDefaulted_GetRef();
+				if (!Read(Match))
+				{
+					return false;
+				}
+			}
+			Decision.RecordedMatches.Sort();
+
+			Decision.bAppliedKnown = Record.NumApplied != AppliedUnknown;
+			Decision.NumApplied = Decision.bAppliedKnown ? Record.NumApplied : 0;
+			for (int32 AppliedIndex = 0; AppliedIndex < Decision.NumApplied; ++AppliedIndex)
+			{
+				FMatch Applied;
+				if (!Read(Applied))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Rule indices are only meaningful within one index, so matches are compared by tags and effect
+	static void ToMatches(const FEAReactionIndex& Index, const FEAReactionIndex::FRuleIndexArray& RuleIndices, TMap<FName, uint32>& NameIndices, FMatchArray& OutMatches)
+	{
+		auto GetNameIndex = [&NameIndices](FName Name)
+		{
+			if (Name.IsNone())
+			{
+				return EACombatLog::NoName;
+			}
+			// Names the recording never saw get fresh indices, so they cannot collide with recorded ones
+			return NameIndices.FindOrAdd(Name, static_cast<uint32>(NameIndices.Num()));
+		};
+
+		OutMatches.Reset();
+		for (const int32 RuleIndex : RuleIndices)
+		{
+			const FElementalReactionRule& Rule = Index.GetRule(RuleIndex);
+
+			EACombatLog::FMatch& Match = OutMatches.AddDefaulted_GetRef();
+			Match.SourceTag = GetNameIndex(Rule.SourceTag.GetTagName());
+			Match.TargetTag = GetNameIndex(Rule.TargetTag.GetTagName());
+			Match.ReactionEffect = Rule.ReactionEffect ? GetNameIndex(Rule.ReactionEffect->GetFName()) : EACombatLog::NoName;
+		}
+		OutMatches.Sort();
+	}
+
+	static FString DescribeMatches(const FMatchArray& Matches, const TArray<FName>& NamesByIndex)
+	{
+		auto NameAt = [&NamesByIndex](uint32 NameIndex)
+		{
+			return NamesByIndex.IsValidIndex(NameIndex) ? NamesByIndex[NameIndex].ToString() : FString(TEXT("?"));
+		};
+
+		TArray<FString> Parts;
+		for (const EACombatLog::FMatch& Match : Matches)
+		{
+			Parts.Add(FString::Printf(TEXT("%s + %s -> %s"), *NameAt(Match.SourceTag), *NameAt(Match.TargetTag), *NameAt(Match.ReactionEffect)));
+		}
+		return Parts.Num() > 0 ? FString::Join(Parts, TEXT(", ")) : FString(TEXT("none"));
+	}
+}
+
+UEAReplayCombatLogCommandlet::UEAReplayCombatLogCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UEAReplayCombatLogCommandlet::Main(const FString& Params)
+{
+	using namespace EAReplayCombatLog;
+
+	FString LogPath;
+	FString RuleSetPaths;
+	int32 NumIterations = 10;
+	int32 MaxDiffs = 20;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("ElementalArsenalReplay.json");
+
+	FParse::Value(*Params, TEXT("Log="), LogPath);
+	FParse::Value(*Params, TEXT("RuleSet="), RuleSetPaths, false);
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	FParse::Value(*Params, TEXT("MaxDiffs="), MaxDiffs);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	if (LogPath.IsEmpty())
+	{
+		UE_LOG(LogEAReplay, Error, TEXT("EAReplayCombatLog: Missing -Log=<file.eacr>"));
+		return 1;
+	}
+
+	// 1. Map the log and decode it once
+	TArray<FName> Names;
+	TArray<FDecision> Decisions;
+	{
+		TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*LogPath));
+		TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() ? MappedFile->MapRegion(0, MappedFile->GetFileSize()) : nullptr);
+
+		if (!MappedRegion.IsValid())
+		{
+			UE_LOG(LogEAReplay, Error, TEXT("EAReplayCombatLog: Could not map %s"), *LogPath);
+			return 1;
+		}
+
+		const bool bDecoded = DecodeLog(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), Names, Decisions);
+
+		// The region has to go before its file handle
+		MappedRegion.Reset();
+		MappedFile.Reset();
+
+		if (!bDecoded)
+		{
+			UE_LOG(LogEAReplay, Error, TEXT("EAReplayCombatLog: %s is not a combat log of version %u, or is truncated."), *LogPath, EACombatLog::Version);
+			return 1;
+		}
+	}
+
+	// 2. Rules to replay against
+	TSharedPtr<const FEAReactionIndex, ESPMode::ThreadSafe> Index;
+	TArray<FString> RuleSetNames;
+
+	if (RuleSetPaths.IsEmpty())
+	{
+		const UEAReactionSubsystem* ReactionSubsystem = UEAReactionSubsystem::Get();
+		if (!ReactionSubsystem)
+		{
+			UE_LOG(LogEAReplay, Error, TEXT("EAReplayCombatLog: Reaction subsystem is not available."));
+			return 1;
+		}
+		Index = ReactionSubsystem->GetReactionIndex();
+	}
+	else
+	{
+		TArray<FString> Paths;
+		RuleSetPaths.ParseIntoArray(Paths, TEXT("+"));
+
+		TArray<const UEAReactionRuleSet*> RuleSets;
+		for (const FString& Path : Paths)
+		{
+			const UEAReactionRuleSet* RuleSet = LoadObject<UEAReactionRuleSet>(nullptr, *Path);
+			if (!RuleSet)
+			{
+				UE_LOG(LogEAReplay, Error, TEXT("EAReplayCombatLog: Could not load rule set %s"), *Path);
+				return 1;
+			}
+			RuleSets.Add(RuleSet);
+			RuleSetNames.Add(RuleSet->GetPathName());
+		}
+		// The recording matched the project rules too, so only the rule sets are swapped
+		Index = FEAReactionIndex::Build(GetDefault<UEAReactionSettings>()->ReactionRules, RuleSets);
+	}
+
+	// 3. Diff against the recorded decisions
+	TMap<FName, uint32> NameIndices;
+	for (int32 NameIndex = 0; NameIndex < Names.Num(); ++NameIndex)
+	{
+		NameIndices.Add(Names[NameIndex], NameIndex);
+	}
+
+	int32 NumChanged = 0;
+	int64 NumRecordedReactions = 0;
+	int64 NumRecordedApplied = 0;
+	int32 NumAppliedUnknown = 0;
+	int64 NumReplayedReactions = 0;
+	int64 NumAdded = 0;
+	int64 NumRemoved = 0;
+
+	FEAReactionIndex::FRuleIndexArray RuleIndices;
+	FMatchArray ReplayedMatches;
+
+	for (const FDecision& Decision : Decisions)
+	{
+		RuleIndices.Reset();
+		Index->FindMatchingRules(Decision.SourceTags, Decision.TargetTags, RuleIndices);
+		ToMatches(*Index, RuleIndices, NameIndices, ReplayedMatches);
+
+		NumRecordedReactions += Decision.RecordedMatches.Num();
+		NumRecordedApplied += Decision.NumApplied;
+		NumAppliedUnknown += Decision.bAppliedKnown ? 0 : 1;
+		NumReplayedReactions += ReplayedMatches.Num();
+
+		if (ReplayedMatches == Decision.RecordedMatches)
+		{
+			continue;
+		}
+
+		for (const EACombatLog::FMatch& Match : ReplayedMatches)
+		{
+			NumAdded += Decision.RecordedMatches.Contains(Match) ? 0 : 1;
+		}
+		for (const EACombatLog::FMatch& Match : Decision.RecordedMatches)
+		{
+			NumRemoved += ReplayedMatches.Contains(Match) ? 0 : 1;
+		}
+
+		if (NumChanged++ < MaxDiffs)
+		{
+			// Includes names only the replay rules use
+			TArray<FName> NamesByIndex;
+			NamesByIndex.SetNum(NameIndices.Num());
+			for (const TPair<FName, uint32>& Entry : NameIndices)
+			{
+				NamesByIndex[Entry.Value] = Entry.Key;
+			}
+
+			UE_LOG(LogEAReplay, Display, TEXT("Frame %llu: %s vs %s | recorded: %s | replayed: %s"),
+				Decision.Frame,
+				*Decision.SourceTags.ToStringSimple(),
+				*Decision.TargetTags.ToStringSimple(),
+				*DescribeMatches(Decision.RecordedMatches, NamesByIndex),
+				*DescribeMatches(ReplayedMatches, NamesByIndex));
+		}
+	}
+
+	// 4. Time the matching alone
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (const FDecision& Decision : Decisions)
+		{
+			RuleIndices.Reset();
+			Index->FindMatchingRules(Decision.SourceTags, Decision.TargetTags, RuleIndices);
+		}
+	}
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	const double NsPerDecision = Decisions.Num() > 0 ? ElapsedSeconds * 1e9 / (double(Decisions.Num()) * NumIterations) : 0.0;
+
+	// 5. Report
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("log"), LogPath);
+	Root->SetStringField(TEXT("rules"), RuleSetNames.Num() > 0 ? TEXT("project+") + FString::Join(RuleSetNames, TEXT("+")) : FString(TEXT("project")));
+	Root->SetNumberField(TEXT("rule_count"), Index->NumRules());
+	Root->SetNumberField(TEXT("decisions"), Decisions.Num());
+	Root->SetNumberField(TEXT("changed_decisions"), NumChanged);
+	Root->SetNumberField(TEXT("recorded_reactions"), static_cast<double>(NumRecordedReactions));
+	Root->SetNumberField(TEXT("recorded_applied_reactions"), static_cast<double>(NumRecordedApplied));
+	Root->SetNumberField(TEXT("decisions_applied_unknown"), NumAppliedUnknown);
+	Root->SetNumberField(TEXT("replayed_reactions"), static_cast<double>(NumReplayedReactions));
+	Root->SetNumberField(TEXT("added_reactions"), static_cast<double>(NumAdded));
+	Root->SetNumberField(TEXT("removed_reactions"), static_cast<double>(NumRemoved));
+	Root->SetNumberField(TEXT("iterations"), NumIterations);
+	Root->SetNumberField(TEXT("ns_per_decision"), NsPerDecision);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	UE_LOG(LogEAReplay, Display, TEXT("%s"), *Json);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogEAReplay, Error, TEXT("EAReplayCombatLog: Could not write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogEAReplay, Display, TEXT("EAReplayCombatLog: Results written to %s"), *OutputPath);
+	return 0;
+}
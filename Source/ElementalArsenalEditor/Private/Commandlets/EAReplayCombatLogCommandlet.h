@@ -0,0 +1,31 @@
+// Copyright NeoNexus Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EAReplayCombatLogCommandlet.generated.h"
+
+/**
+ * Replays a combat log recorded with ea.CombatLog.Start against a rule set and reports how the rules the index
+ * matches differ from the recorded matches, plus the time spent matching. The log is memory mapped and decoded once
+ * up front; only rule matching is timed. Reactions the recording actually applied (after the self-reaction guard,
+ * cooldowns and frame budget) depend on runtime state, so they are counted but not diffed.
+ *
+ * By default the decisions are made with the project's current rules and registered rule sets. -RuleSet keeps the
+ * project's ReactionRules and replaces the registered rule sets with the given UEAReactionRuleSet assets
+ * (separated by '+').
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=EAReplayCombatLog -Log=<file.eacr> -nullrhi -unattended
+ *     [-RuleSet=/Game/Reactions/RS_New.RS_New] [-Iterations=10] [-MaxDiffs=20] [-Output=<file.json>]
+ */
+UCLASS()
+class UEAReplayCombatLogCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEAReplayCombatLogCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};